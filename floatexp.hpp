@@ -0,0 +1,96 @@
+//Extended-range double: a double mantissa with a separate 64-bit exponent, value = m * 2^e.  Same 53-bit precision as double, but it neither underflows
+//nor overflows at any zoom this program can reach, so the perturbation renderer's pixel deltas keep working below 1e-308 where plain doubles go to zero.
+//Only the operations the perturbation code needs are provided.  It is not meant for the first_float/second_float/third_float typedefs.
+#ifndef FLOATEXP_HPP
+#define FLOATEXP_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <iostream>
+#include <algorithm>
+
+class floatexp {
+public:
+    double m;     //Mantissa, 1<=|m|<2, or 0, inf or NaN
+    long long e;  //Binary exponent.  0 when m is 0, inf or NaN
+
+    floatexp() : m(0.0), e(0) {}
+    floatexp(double d) : m(d), e(0) { Normalize(); }
+    floatexp(int i) : m((double)i), e(0) { Normalize(); }
+    floatexp(double mantissa, long long exponent) : m(mantissa), e(exponent) { Normalize(); }
+
+    //Saturates to 0 or inf outside double's range
+    explicit operator double() const {
+        if (e>INT_MAX) return std::ldexp(m,INT_MAX);
+        if (e<INT_MIN) return std::ldexp(m,INT_MIN);
+        return std::ldexp(m,(int)e);
+    }
+
+    friend floatexp operator*(const floatexp &a, const floatexp &b) { return floatexp(a.m*b.m,a.e+b.e); }
+    friend floatexp operator+(const floatexp &a, const floatexp &b) {
+        if (a.m==0.0) return b;
+        if (b.m==0.0) return a;
+        long long shift=a.e-b.e;
+        if (shift>=0) return (shift>60)?a:floatexp(a.m+b.m*Pow2(-(int)shift),a.e);
+        return (shift<-60)?b:floatexp(b.m+a.m*Pow2((int)shift),b.e);
+    }
+    friend floatexp operator-(const floatexp &a) { floatexp r=a; r.m=-r.m; return r; }
+    friend floatexp operator-(const floatexp &a, const floatexp &b) { return a+(-b); }
+    floatexp& operator+=(const floatexp &b) { return *this=*this+b; }
+    floatexp& operator-=(const floatexp &b) { return *this=*this-b; }
+    floatexp& operator*=(const floatexp &b) { return *this=*this*b; }
+
+    //Comparisons are false if either side is NaN, as for double
+    friend bool operator<(const floatexp &a, const floatexp &b) { return (a-b).m<0.0; }
+    friend bool operator>(const floatexp &a, const floatexp &b) { return (a-b).m>0.0; }
+    friend bool operator<=(const floatexp &a, const floatexp &b) { return (a-b).m<=0.0; }
+    friend bool operator>=(const floatexp &a, const floatexp &b) { return (a-b).m>=0.0; }
+    friend bool operator==(const floatexp &a, const floatexp &b) { return (a.m==b.m)&&(a.e==b.e); }
+    friend bool operator!=(const floatexp &a, const floatexp &b) { return !(a==b); }
+
+    friend floatexp ldexp(const floatexp &a, long long n) { return (a.m==0.0)?a:floatexp(a.m,a.e+n); }
+    friend floatexp abs(const floatexp &a) { floatexp r=a; r.m=std::fabs(r.m); return r; }
+
+    //Prints in decimal scientific notation with an exponent of any size, e.g. 1.5e-4000
+    friend std::ostream& operator<<(std::ostream &os, const floatexp &a) {
+        if ((a.m==0.0)||!std::isfinite(a.m)) return os<<a.m;
+        double log10Value=std::log10(std::fabs(a.m))+(double)a.e*0.30102999566398119521;
+        double exponent10=std::floor(log10Value);
+        double mantissa10=std::pow(10.0,log10Value-exponent10);
+        std::streamsize oldPrecision=os.precision(std::min<std::streamsize>(os.precision(),15));  //The rest would be noise from the log/pow round trip
+        os<<(a.m<0.0?"-":"")<<mantissa10<<"e"<<(long long)exponent10;
+        os.precision(oldPrecision);
+        return os;
+    }
+
+private:
+    //Exact power of two for |n|<=1022, built directly from the bit pattern
+    static double Pow2(int n) {
+        uint64_t bits=(uint64_t)(n+1023)<<52;
+        double d;
+        std::memcpy(&d,&bits,sizeof d);
+        return d;
+    }
+
+    //Moves the exponent of m into e, leaving 1<=|m|<2.  Reads the exponent field directly since frexp is comparatively slow.
+    void Normalize() {
+        uint64_t bits;
+        std::memcpy(&bits,&m,sizeof bits);
+        int field=(int)((bits>>52)&0x7FF);
+        if (field==0x7FF) { e=0; return; }  //inf or NaN
+        if (field==0) {                      //Zero or denormal
+            if (m==0.0) { e=0; return; }
+            int ex;
+            m=std::frexp(m,&ex)*2.0;
+            e+=ex-1;
+            return;
+        }
+        e+=field-1023;
+        bits=(bits&~(0x7FFULL<<52))|(1023ULL<<52);
+        std::memcpy(&m,&bits,sizeof m);
+    }
+};
+
+#endif // FLOATEXP_HPP
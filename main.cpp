@@ -1,1099 +1,1155 @@
-#include <iostream>
-#include <vector>
-#include <string>
-#include <thread>
-#include <future>
-#include <chrono>
-#include <limits>
-
-#include "raylib.h"
-// Info on standard boost::mp and number class functions:
-// https://www.boost.org/doc/libs/1_76_0/libs/multiprecision/doc/html/boost_multiprecision/ref/backendconc.html
-#define BOOST_MP_DISABLE_DEPRECATE_03_WARNING 1 //Get rid of warning
-#include "boost/multiprecision/cpp_bin_float.hpp"
-
-using namespace std;
-using namespace boost::multiprecision;
-using namespace std::chrono_literals; //For 0s to pass to futures.wait_for()
-
-//Convenience type definitions for various levels of precision for cpp_bin_float
-typedef number<backends::cpp_bin_float<24, backends::digit_base_2, void, std::int16_t, -126, 127>, et_off>         cpp_bin_float_single;
-typedef number<backends::cpp_bin_float<53, backends::digit_base_2, void, std::int16_t, -1022, 1023>, et_off>       cpp_bin_float_double;
-typedef number<backends::cpp_bin_float<64, backends::digit_base_2, void, std::int16_t, -16382, 16383>, et_off>     cpp_bin_float_double_extended;
-typedef number<backends::cpp_bin_float<113, backends::digit_base_2, void, std::int16_t, -16382, 16383>, et_off>    cpp_bin_float_quad;
-typedef number<backends::cpp_bin_float<237, backends::digit_base_2, void, std::int32_t, -262142, 262143>, et_off>  cpp_bin_float_oct;
-typedef number<backends::cpp_bin_float<500, backends::digit_base_2, void, std::int32_t, -262142, 262143>, et_off>  cpp_bin_float_500;
-typedef number<backends::cpp_bin_float<1000, backends::digit_base_2, void, std::int32_t, -262142, 262143>, et_off> cpp_bin_float_1000;
-
-// OPTION: Set your floating point types below.  Varies cpp_bin_float types have been defined above for convenience.
-typedef double first_float;
-typedef cpp_bin_float_quad second_float;
-typedef cpp_bin_float_oct third_float;
-
-//For pixel-based screen locations in RayLib
-struct int_vector2 {
-    int x;
-    int y;
-};
-
-//Simple complex number types with only the operations that we need for the Mandelbrot set
-class MyComplex_first_float {
-public:
-    first_float real;
-    first_float imag;
-    MyComplex_first_float(){
-        real=0;
-        imag=0;
-    }
-    MyComplex_first_float(first_float r, first_float i){
-        real=r;
-        imag=i;
-    }
-    MyComplex_first_float operator+(const MyComplex_first_float &rhs) {
-        MyComplex_first_float r;
-        r.real=this->real+rhs.real;
-        r.imag=this->imag+rhs.imag;
-        return r;
-    }
-    MyComplex_first_float operator*(const MyComplex_first_float &rhs) {
-        MyComplex_first_float r;                                    // (a+bi)*(c+di) = (ac-bd)+(ad+bc)i
-        r.real=(this->real)*rhs.real-(this->imag)*rhs.imag;
-        r.imag=(this->real)*rhs.imag+(this->imag)*rhs.real;
-        return r;
-    }
-    MyComplex_first_float Squared() {
-        MyComplex_first_float r;
-        r.real=(this->real)*(this->real)-(this->imag)*(this->imag); // a^2-b^2
-        r.imag=(this->real)*(this->imag)+(this->real)*(this->imag); // 2abi
-        return r;
-    }
-    first_float Magnitude() {
-        first_float r;
-        r=(this->real)*(this->real)+(this->imag)*(this->imag);
-        return r;
-    }
-};
-
-class MyComplex_second_float {
-public:
-    second_float real;
-    second_float imag;
-    MyComplex_second_float(){
-        real=0;
-        imag=0;
-    }
-    MyComplex_second_float(second_float r, second_float i){
-        real=r;
-        imag=i;
-    }
-    MyComplex_second_float(MyComplex_first_float f) {
-        real=second_float(f.real);
-        imag=second_float(f.imag);
-    }
-    MyComplex_second_float operator+(const MyComplex_second_float &rhs) {
-        MyComplex_second_float r;
-        r.real=this->real+rhs.real;
-        r.imag=this->imag+rhs.imag;
-        return r;
-    }
-    MyComplex_second_float operator*(const MyComplex_second_float &rhs) {
-        MyComplex_second_float r;                                    // (a+bi)*(c+di) = (ac-bd)+(ad+bc)i
-        r.real=(this->real)*rhs.real-(this->imag)*rhs.imag;
-        r.imag=(this->real)*rhs.imag+(this->imag)*rhs.real;
-        return r;
-    }
-    MyComplex_second_float Squared() {
-        MyComplex_second_float r;
-        r.real=(this->real)*(this->real)-(this->imag)*(this->imag); // a^2-b^2
-        r.imag=(this->real)*(this->imag)+(this->real)*(this->imag); // 2abi
-        return r;
-    }
-    second_float Magnitude() {
-        second_float r;
-        r=(this->real)*(this->real)+(this->imag)*(this->imag);
-        return r;
-    }
-};
-
-class MyComplex_third_float {
-public:
-    third_float real;
-    third_float imag;
-    MyComplex_third_float(){
-        real=0;
-        imag=0;
-    }
-    MyComplex_third_float(third_float r, third_float i){
-        real=r;
-        imag=i;
-    }
-    MyComplex_third_float(MyComplex_first_float f){
-        real=third_float(f.real);
-        imag=third_float(f.imag);
-    }
-    MyComplex_third_float operator+(const MyComplex_third_float &rhs) {
-        MyComplex_third_float r;
-        r.real=this->real+rhs.real;
-        r.imag=this->imag+rhs.imag;
-        return r;
-    }
-    MyComplex_third_float operator*(const MyComplex_third_float &rhs) {
-        MyComplex_third_float r;                                    // (a+bi)*(c+di) = (ac-bd)+(ad+bc)i
-        r.real=(this->real)*rhs.real-(this->imag)*rhs.imag;
-        r.imag=(this->real)*rhs.imag+(this->imag)*rhs.real;
-        return r;
-    }
-    MyComplex_third_float Squared() {
-        MyComplex_third_float r;
-        r.real=(this->real)*(this->real)-(this->imag)*(this->imag); // a^2-b^2
-        r.imag=(this->real)*(this->imag)+(this->real)*(this->imag); // 2abi
-        return r;
-    }
-    third_float Magnitude() {
-        third_float r;
-        r=(this->real)*(this->real)+(this->imag)*(this->imag);
-        return r;
-    }
-};
-
-std::ostream& operator<< (std::ostream& os, MyComplex_first_float f) {
-    os<<"( "<<f.real<<" + "<<f.imag<<" i)";
-    return os;
-}
-
-std::ostream& operator<< (std::ostream& os, MyComplex_second_float f) {
-    os<<"( "<<f.real<<" + "<<f.imag<<" i)";
-    return os;
-}
-
-std::ostream& operator<< (std::ostream& os, MyComplex_third_float f) {
-    os<<"( "<<f.real<<" + "<<f.imag<<" i)";
-    return os;
-}
-
-//Our fundamental class for relating int_vector2 screen coordinates to the values they represent and storing the iterations calculated for each
-class PointToCalc_first_float {
-public:
-    int_vector2 gridPos; //Grid position for plotting
-    MyComplex_first_float coord;
-    int iterations;
-};
-
-class PointToCalc_second_float {
-public:
-    int_vector2 gridPos; //Grid position for plotting
-    MyComplex_second_float coord;
-    int iterations;
-};
-
-class PointToCalc_third_float {
-public:
-    int_vector2 gridPos; //Grid position for plotting
-    MyComplex_third_float coord;
-    int iterations;
-};
-
-//Pairs of iterators to the above types for indicating start and end points of batches of work for the multithreaded functions that compute the iterations
-struct iterPair_first_float {
-    vector<PointToCalc_first_float>::iterator startIter;
-    vector<PointToCalc_first_float>::iterator endIter;
-};
-
-struct iterPair_second_float {
-    vector<PointToCalc_second_float>::iterator startIter;
-    vector<PointToCalc_second_float>::iterator endIter;
-};
-
-struct iterPair_third_float {
-    vector<PointToCalc_third_float>::iterator startIter;
-    vector<PointToCalc_third_float>::iterator endIter;
-};
-
-//TODO: Use of 1ULL will limit depth of zoom to 2^64.
-//Takes a screen coordinate and transforms it to a complex type of our selected precision
-MyComplex_first_float Grid2Coord_first_float(int_vector2 gc, MyComplex_first_float &coordCenter, unsigned int &zoomDenomPower) {
-    MyComplex_first_float p;
-    first_float d=(first_float)(1ULL<<zoomDenomPower);
-    p.real=coordCenter.real+((first_float)(gc.x-512))/d;
-    p.imag=coordCenter.imag+((first_float)(512-gc.y))/d;
-    return p;
-}
-
-MyComplex_second_float Grid2Coord_second_float(int_vector2 gc, MyComplex_second_float &coordCenter, unsigned int &zoomDenomPower) {
-    MyComplex_second_float p;
-    second_float d=(second_float)(1ULL<<zoomDenomPower);
-    p.real=coordCenter.real+((second_float)(gc.x-512))/d;
-    p.imag=coordCenter.imag+((second_float)(512-gc.y))/d;
-    return p;
-}
-
-MyComplex_third_float Grid2Coord_third_float(int_vector2 gc, MyComplex_third_float &coordCenter, unsigned int &zoomDenomPower) {
-    MyComplex_third_float p;
-    third_float d=(third_float)(1ULL<<zoomDenomPower);
-    p.real=coordCenter.real+((third_float)(gc.x-512))/d;
-    p.imag=coordCenter.imag+((third_float)(512-gc.y))/d;
-    return p;
-}
-
-//Inverse function to the above.  Transforms complex type to screen coordinate.  Only used for plotting point trajectories in screen 8 view
-int_vector2 Coord2Grid_first_float(MyComplex_first_float c){
-    first_float xf=c.real*256.0;
-    first_float yf=c.imag*256.0;
-    int_vector2 gc;
-    gc.x=int(xf)+512;
-    gc.y=512-int(yf);
-    return gc;
-}
-
-int_vector2 Coord2Grid_second_float(MyComplex_second_float c){
-    second_float xf=c.real*256.0;
-    second_float yf=c.imag*256.0;
-    int_vector2 gc;
-    gc.x=int(xf)+512;
-    gc.y=512-int(yf);
-    return gc;
-}
-
-int_vector2 Coord2Grid_third_float(MyComplex_third_float c){
-    third_float xf=c.real*256.0;
-    third_float yf=c.imag*256.0;
-    int_vector2 gc;
-    gc.x=int(xf)+512;
-    gc.y=512-int(yf);
-    return gc;
-}
-
-inline bool mouseIsInBounds(Vector2 m) {
-    return ( (m.x>1)&&(m.x<1024)&&(m.y>1)&&(m.y<1024) );
-}
-
-//Core function to calculate iteration value for just one point
-void msetPoint_first_float(vector<PointToCalc_first_float>::iterator pit, int maxIterations) {
-    MyComplex_first_float c;
-    first_float maxMagnitude=first_float(4.0);
-    int iterationCounter=0;
-
-    while ( (c.Magnitude()<maxMagnitude) && (iterationCounter<maxIterations) ) {
-        c=c.Squared()+pit->coord;
-        iterationCounter++;
-    }
-
-    if (iterationCounter<maxIterations) {  //We have bounded out
-            pit->iterations=iterationCounter;
-            return;
-    }
-    //Otherwise, we've hit max iter, return zero
-    pit->iterations=0;
-    return;
-}
-
-void msetPoint_second_float(vector<PointToCalc_second_float>::iterator pit, int maxIterations) {
-    MyComplex_second_float c;
-    second_float maxMagnitude=second_float(4.0);
-    int iterationCounter=0;
-
-    while ( (c.Magnitude()<maxMagnitude) && (iterationCounter<maxIterations) ) {
-        c=c.Squared()+pit->coord;
-        iterationCounter++;
-    }
-
-    if (iterationCounter<maxIterations) {
-            pit->iterations=iterationCounter;
-            return;
-    }
-    pit->iterations=0;
-    return;
-}
-
-void msetPoint_third_float(vector<PointToCalc_third_float>::iterator pit, int maxIterations) {
-    MyComplex_third_float c;
-    third_float maxMagnitude=third_float(4.0);
-    int iterationCounter=0;
-
-    while ( (c.Magnitude()<maxMagnitude) && (iterationCounter<maxIterations) ) {
-        c=c.Squared()+pit->coord;
-        iterationCounter++;
-    }
-
-    if (iterationCounter<maxIterations) {
-            pit->iterations=iterationCounter;
-            return;
-    }
-    pit->iterations=0;
-    return;
-}
-
-//Wraps the above functions to work with start-end pairs of iterators.  The same iterators are returned because with std::async execution and future.get(), work is not necessarily returned in the same order that
-//we submitted it, so we need to know what batch of pixels was just completed.  We only draw newly-computed pixels to their respective screen textures, rather than plotting 3x1024x1024 pixels every frame
-iterPair_first_float msetBatch_first_float(iterPair_first_float vit, int maxIterations) {
-    for (vector<PointToCalc_first_float>::iterator it=vit.startIter; it!=vit.endIter; it++) {
-        msetPoint_first_float(it,maxIterations);
-    }
-return vit;
-}
-
-iterPair_second_float msetBatch_second_float(iterPair_second_float vit, int maxIterations) {
-    for (vector<PointToCalc_second_float>::iterator it=vit.startIter; it!=vit.endIter; it++) {
-        msetPoint_second_float(it,maxIterations);
-    }
-return vit;
-}
-
-iterPair_third_float msetBatch_third_float(iterPair_third_float vit, int maxIterations) {
-    for (vector<PointToCalc_third_float>::iterator it=vit.startIter; it!=vit.endIter; it++) {
-        msetPoint_third_float(it,maxIterations);
-    }
-return vit;
-}
-
-//These functions return a list of points for plotting the trajectory of a point in screen 8 display mode.  Shows how different precision give rise to different trajectories,
-//which in turn gives rise to different iteration values for different precisions
-vector<int_vector2> msetPath_first_float(MyComplex_first_float c, int maxIterations) {
-    MyComplex_first_float z;
-    vector<int_vector2> points;
-    first_float maxMagnitude=first_float(4.0);
-    int iterationCounter=0;
-
-    while ( (z.Magnitude()<maxMagnitude) && (iterationCounter<maxIterations) ) {
-        z=z.Squared()+c;
-        iterationCounter++;
-        points.push_back(Coord2Grid_first_float(z));
-    }
-return points;
-}
-
-vector<int_vector2> msetPath_second_float(MyComplex_second_float c, int maxIterations) {
-    MyComplex_second_float z;
-    vector<int_vector2> points;
-    second_float maxMagnitude=second_float(4.0);
-    int iterationCounter=0;
-
-    while ( (z.Magnitude()<maxMagnitude) && (iterationCounter<maxIterations) ) {
-        z=z.Squared()+c;
-        iterationCounter++;
-        points.push_back(Coord2Grid_second_float(z));
-    }
-return points;
-}
-
-vector<int_vector2> msetPath_third_float(MyComplex_third_float c, int maxIterations) {
-    MyComplex_third_float z;
-    vector<int_vector2> points;
-    third_float maxMagnitude=third_float(4.0);
-    int iterationCounter=0;
-
-    while ( (z.Magnitude()<maxMagnitude) && (iterationCounter<maxIterations) ) {
-        z=z.Squared()+c;
-        iterationCounter++;
-        points.push_back(Coord2Grid_third_float(z));
-    }
-return points;
-}
-
-//TODO: Get a more attractive palette function
-//Iterations-to-color for main image
-Color colorizer(int iter) {
-    if (iter<=0) return BLACK;
-    Color c;
-    c.a=255;
-    c.r=64+12*(iter%16);
-    c.g=8*((iter/16)%32);
-    c.b=16*((iter/512)%32);
-return c;
-}
-
-//Returns color used when subtracting two images, using only red, green and black
-Color colorizePixelDiff(int i) {
-    Color c=BLACK;
-    if (i>0) {
-        c.g=(unsigned char)(128+31*(i%4));
-    }
-    if (i<0) {
-        i=-i;
-        c.r=(unsigned char)(128+31*(i%4));;
-    }
-return c;
-}
-
-//For raylib DrawText function
-char* PrintNum(char* c, int n) {
-    snprintf(c,10,"%i",n);
-return c;
-}
-
-int main()
-{
-
-    Vector2 mousePos;
-    int_vector2 gridPos;
-    unsigned int zoomDenomPower=8;
-    MyComplex_first_float coordCenter_first_float;
-    MyComplex_second_float coordCenter_second_float;
-    MyComplex_third_float coordCenter_third_float;
-    MyComplex_first_float oldCoordCenter_first_float;
-    MyComplex_second_float oldCoordCenter_second_float;
-    MyComplex_third_float oldCoordCenter_third_float;
-    int maxIterations=100;
-    bool doNewCalc=false;
-    bool recalcSamePoints=false;
-    bool pauseCalc=false;
-    bool eraseScreen=true;
-    bool highlightCenterOfScreen=false;
-    bool showGrid=false;
-    bool calcDifference=false;
-    bool drawThreePaths=false;
-    char smallText[40];
-    unsigned int displayScreen=1;
-
-    // OPTION: Increase or decrease numThreads for your system.  Note: numThreads*3 threads are launched initially because numThreads threads runs per type.
-    unsigned int numThreads=5;
-
-    // OPTION: Change batch size for the three types here.
-    unsigned int batchSize_first_float=10240;
-    unsigned int batchSize_second_float=5120;
-    unsigned int batchSize_third_float=1024;
-
-    //Initialize arrays to hold our points to calculate for each type
-    vector<PointToCalc_first_float> pointsToCalc_first_float(1024*1024);
-    vector<PointToCalc_second_float> pointsToCalc_second_float(1024*1024);
-    vector<PointToCalc_third_float> pointsToCalc_third_float(1024*1024);
-
-    //Initialize arrays that hold differences of iteration value between the above.  2M1 = type 2 - type 1, etc.
-    vector<int>differentPixels2M1(1024*1024);
-    vector<int>differentPixels3M1(1024*1024);
-    vector<int>differentPixels3M2(1024*1024);
-
-    cout<<setprecision(33);
-    //Print our numeric limits for our types
-    cout<<"Limits of types:"<<endl;
-    cout<<"1st float type:\n\tRadix digits: "<<std::numeric_limits<first_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<first_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<first_float>::epsilon()<<"\tmin: "<<std::numeric_limits<first_float>::min()<<"\tMin exponent: "<<std::numeric_limits<first_float>::min_exponent<<"\n\n";
-    cout<<"2nd float type:\n\tRadix digits: "<<std::numeric_limits<second_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<second_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<second_float>::epsilon()<<"\tmin: "<<std::numeric_limits<second_float>::min()<<"\tMin exponent: "<<std::numeric_limits<second_float>::min_exponent<<"\n\n";
-    cout<<"3rd float type:\n\tRadix digits: "<<std::numeric_limits<third_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<third_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<third_float>::epsilon()<<"\tmin: "<<std::numeric_limits<third_float>::min()<<"\tMin exponent: "<<std::numeric_limits<third_float>::min_exponent<<"\n\n";
-    cout<<"Iteration difference type: Base 10 digits: "<<std::numeric_limits<int>::digits10<<" Max: "<<(int)std::numeric_limits<int>::max()<<endl;
-
-    //Initialize first display
-    cout<<"Initializing point list"<<endl;
-    for (gridPos.y=0;gridPos.y<1024;gridPos.y++) {
-        for (gridPos.x=0;gridPos.x<1024;gridPos.x++) {
-            pointsToCalc_first_float[1024*gridPos.y+gridPos.x].gridPos=gridPos;
-            pointsToCalc_first_float[1024*gridPos.y+gridPos.x].coord=Grid2Coord_first_float(gridPos,coordCenter_first_float,zoomDenomPower);
-            pointsToCalc_first_float[1024*gridPos.y+gridPos.x].iterations=0;
-
-            pointsToCalc_second_float[1024*gridPos.y+gridPos.x].gridPos=gridPos;
-            pointsToCalc_second_float[1024*gridPos.y+gridPos.x].iterations=0;
-
-            pointsToCalc_third_float[1024*gridPos.y+gridPos.x].gridPos=gridPos;
-            pointsToCalc_third_float[1024*gridPos.y+gridPos.x].iterations=0;
-
-            // OPTION: Select whether higher-precision types calculate starting point C (in Z=Z^2+C) using their own precision, or whether they cast the result of the first type's calculation, retaining its more limited precision
-            // Relevant when lower-precision floats lose accuracy with higher zooms.  Casting the value ensures that all three float types start with the same initial value for point C,
-            // and thus any subsequent divergence in iteration value is from accumulated error due to the types themselves and not their slightly different starting values.
-            // Not casting means that all three types may start with slightly different values for C depending on the depth of zoom.
-            // NOTE: You must change the same set of statements in the doNewCalc routine to match!  This section of code only affects the initial image.
-            pointsToCalc_second_float[1024*gridPos.y+gridPos.x].coord=Grid2Coord_second_float(gridPos,coordCenter_second_float,zoomDenomPower);  // Calculate second type's starting point using second type's precision
-            //pointsToCalc_second_float[1024*gridPos.y+gridPos.x].coord=MyComplex_second_float(Grid2Coord_first_float(gridPos,coordCenter_first_float,zoomDenomPower));  // Second type's starting point casts the first type's result, keeping its more limited precision
-
-            pointsToCalc_third_float[1024*gridPos.y+gridPos.x].coord=Grid2Coord_third_float(gridPos,coordCenter_third_float,zoomDenomPower);  // Calculate third type's starting point in third type's precision
-            //pointsToCalc_third_float[1024*gridPos.y+gridPos.x].coord=MyComplex_third_float(Grid2Coord_first_float(gridPos,coordCenter_first_float,zoomDenomPower)); // Third type's starting point casts the first type's result, keeping its more limited precision
-        }
-    }
-
-    //Initialize pointers for batches of work
-    iterPair_first_float batchIter_first_float;
-    batchIter_first_float.startIter=pointsToCalc_first_float.begin();
-    batchIter_first_float.endIter=batchIter_first_float.startIter+batchSize_first_float;
-    iterPair_first_float drawIter_first_float;
-    drawIter_first_float.startIter=pointsToCalc_first_float.begin();
-    drawIter_first_float.endIter=pointsToCalc_first_float.begin(); //set to same as above because nothing to draw initially
-
-    iterPair_second_float batchIter_second_float;
-    batchIter_second_float.startIter=pointsToCalc_second_float.begin();
-    batchIter_second_float.endIter=batchIter_second_float.startIter+batchSize_second_float;
-    iterPair_second_float drawIter_second_float;
-    drawIter_second_float.startIter=pointsToCalc_second_float.begin();
-    drawIter_second_float.endIter=pointsToCalc_second_float.begin();
-
-    iterPair_third_float batchIter_third_float;
-    batchIter_third_float.startIter=pointsToCalc_third_float.begin();
-    batchIter_third_float.endIter=batchIter_third_float.startIter+batchSize_third_float;
-    iterPair_third_float drawIter_third_float;
-    drawIter_third_float.startIter=pointsToCalc_third_float.begin();
-    drawIter_third_float.endIter=pointsToCalc_third_float.begin();
-
-    //These vectors store pairs of pointers returned from future.get(), representing newly-computed ranges of points, which are then drawn to RenderTextures to update the image
-    vector<iterPair_first_float> rangesToDraw_first_float;
-    vector<iterPair_second_float> rangesToDraw_second_float;
-    vector<iterPair_third_float> rangesToDraw_third_float;
-
-    //Compute basic stats about the work remaining for on-screen progress display
-    unsigned int numPointsFinished=0, numPointsUpdated=0, numPointsToCalc;
-    numPointsToCalc=pointsToCalc_first_float.size()+pointsToCalc_second_float.size()+pointsToCalc_third_float.size();
-
-    //Spin up threads
-    std::future<iterPair_first_float> futures_first_float[numThreads];
-    std::future<iterPair_second_float> futures_second_float[numThreads];
-    std::future<iterPair_third_float> futures_third_float[numThreads];
-
-
-    for (unsigned int t=0;t<numThreads;t++) {
-        futures_first_float[t]=std::async(msetBatch_first_float,batchIter_first_float,maxIterations);
-    }
-
-    for (unsigned int t=0;t<numThreads;t++) {
-        futures_second_float[t]=std::async(msetBatch_second_float,batchIter_second_float,maxIterations);
-    }
-
-    for (unsigned int t=0;t<numThreads;t++) {
-        futures_third_float[t]=std::async(msetBatch_third_float,batchIter_third_float,maxIterations);
-    }
-
-    //Initialize RayLib display and RenderTextures
-    const int screenWidth = 1200;
-    const int screenHeight = 1024;
-    InitWindow(screenWidth, screenHeight, "");
-    SetTargetFPS(30);
-    RenderTexture2D msetRenderTexture_first_float=LoadRenderTexture(1024,1024);
-    RenderTexture2D msetRenderTexture_second_float=LoadRenderTexture(1024,1024);
-    RenderTexture2D msetRenderTexture_third_float=LoadRenderTexture(1024,1024);
-    RenderTexture2D diffScreen2M1=LoadRenderTexture(1024,1024);
-    RenderTexture2D diffScreen3M1=LoadRenderTexture(1024,1024);
-    RenderTexture2D diffScreen3M2=LoadRenderTexture(1024,1024);
-    RenderTexture2D pathDrawings=LoadRenderTexture(1024,1024);
-    RenderTexture2D msetCanvas=LoadRenderTexture(1024,1024);
-
-    //Pre-draw Mandelbrot set on (-2,2) to (2,2) on msetCanvas to make a background for pathDrawings.
-    //The addition of this code makes the first pass on the first float type redundant
-    //Only used on display screen mode 7.  For screen mode 8, it's easier to find interesting points with the zoomed-in image as background.
-    //TODO: Perhaps omit this and screen mode 7 entirely?
-    BeginTextureMode(msetCanvas);
-    for (vector<PointToCalc_first_float>::iterator vit=pointsToCalc_first_float.begin();vit!=pointsToCalc_first_float.end();vit++){
-        msetPoint_first_float(vit,maxIterations);
-        DrawPixel(vit->gridPos.x,vit->gridPos.y,colorizer(vit->iterations));
-    }
-    EndTextureMode();
-
-    //Initialize vectors which hold paths to plot for screen modes 7 and 8 where the trajectory of a point is plotted
-    vector<int_vector2> pathPoints_first_float;
-    vector<int_vector2> pathPoints_second_float;
-    vector<int_vector2> pathPoints_third_float;
-    MyComplex_first_float firstPathPoint_first_float;
-    MyComplex_second_float firstPathPoint_second_float;
-    MyComplex_third_float firstPathPoint_third_float;
-
-    //For drawing textures to screen.  FlipRec has a final value that is negative to flip the Y axis from screen coordinates (+Y is down) to Cartesian (+Y is up)
-    Rectangle flipRec=(Rectangle){0.0f,0.0f,1024.0f,-1024.0f};  //Flips Y-axis
-    Vector2 origin=(Vector2){0.0f,0.0f};
-
-// Begin main loop
-while (!WindowShouldClose())    // Detect window close button or ESC key
-{
-    // Detect user input
-    mousePos=GetMousePosition();
-    if (mouseIsInBounds(mousePos)) {
-        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON) ) {
-                oldCoordCenter_first_float=coordCenter_first_float;
-                oldCoordCenter_second_float=coordCenter_second_float;
-                oldCoordCenter_third_float=coordCenter_third_float;
-                coordCenter_first_float=Grid2Coord_first_float({(int)mousePos.x,(int)mousePos.y},coordCenter_first_float,zoomDenomPower);
-                coordCenter_second_float=Grid2Coord_second_float({(int)mousePos.x,(int)mousePos.y},coordCenter_second_float,zoomDenomPower);
-                coordCenter_third_float=Grid2Coord_third_float({(int)mousePos.x,(int)mousePos.y},coordCenter_third_float,zoomDenomPower);
-                cout<<"Mouse x:"<<mousePos.x<<" y:"<<mousePos.y<<" New center coord x:"<<coordCenter_first_float.real<<" y:"<<coordCenter_first_float.imag<<endl;
-                doNewCalc=true;
-            }
-        if (IsKeyPressed(KEY_SLASH)) {
-            MyComplex_first_float queriedPoint=Grid2Coord_first_float({(int)mousePos.x,(int)mousePos.y},coordCenter_first_float,zoomDenomPower);
-            //cout<<setprecision(33);
-            cout<<"Location as type 1: "<<queriedPoint<<endl;
-            cout<<"Recast as type 2: "<<MyComplex_second_float(queriedPoint)<<endl;
-            cout<<"Recast as type 3: "<<MyComplex_third_float(queriedPoint)<<endl;
-            //cout<<setprecision(16);
-        }
-        if (IsKeyDown(KEY_SEVEN)) {
-                calcDifference=true; pauseCalc=true; displayScreen=7; drawThreePaths=true;
-                firstPathPoint_first_float=Grid2Coord_first_float({(int)mousePos.x,(int)mousePos.y},coordCenter_first_float,zoomDenomPower);
-                firstPathPoint_second_float=Grid2Coord_second_float({(int)mousePos.x,(int)mousePos.y},coordCenter_second_float,zoomDenomPower);
-                firstPathPoint_third_float=Grid2Coord_third_float({(int)mousePos.x,(int)mousePos.y},coordCenter_third_float,zoomDenomPower);
-        }
-        if (IsKeyDown(KEY_EIGHT)) {
-                calcDifference=true; pauseCalc=true; displayScreen=8; drawThreePaths=true;
-                firstPathPoint_first_float=Grid2Coord_first_float({(int)mousePos.x,(int)mousePos.y},coordCenter_first_float,zoomDenomPower);
-                firstPathPoint_second_float=Grid2Coord_second_float({(int)mousePos.x,(int)mousePos.y},coordCenter_second_float,zoomDenomPower);
-                firstPathPoint_third_float=Grid2Coord_third_float({(int)mousePos.x,(int)mousePos.y},coordCenter_third_float,zoomDenomPower);
-        }
-    }
-
-    //TODO:  1<<zoomDenomPower needs to be CPP_INT(1)<<zDP or else overflows when zDP>64
-    if (IsKeyDown(KEY_PERIOD)) { zoomDenomPower++; doNewCalc=true; cout<<"Increasing denom power to "<<zoomDenomPower<<" = 1/"<<(1ULL<<zoomDenomPower)<<endl;}
-    if (IsKeyDown(KEY_SEMICOLON)) { zoomDenomPower+=3; doNewCalc=true; cout<<"Increasing denom power to "<<zoomDenomPower<<" = 1/"<<(1ULL<<zoomDenomPower)<<endl;}
-    if (IsKeyDown(KEY_COMMA)) { zoomDenomPower--; doNewCalc=true; if (zoomDenomPower<6) zoomDenomPower=6; cout<<"Decreasing denom power to "<<zoomDenomPower<<" = 1/"<<(1ULL<<zoomDenomPower)<<endl;}
-    if (IsKeyDown(KEY_M)) {maxIterations++; recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl;}
-    if (IsKeyDown(KEY_N)) {maxIterations--; if (maxIterations<2) maxIterations=2; recalcSamePoints=true; cout<<"Decreasing Max Iter to "<<maxIterations<<endl;}
-    if (IsKeyDown(KEY_K)) {maxIterations+=10; recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl;}
-    if (IsKeyDown(KEY_J)) {maxIterations-=10; if (maxIterations<2) maxIterations=2; recalcSamePoints=true; cout<<"Decreasing Max Iter to "<<maxIterations<<endl;}
-    if (IsKeyDown(KEY_O)) {
-        if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
-            maxIterations=((maxIterations/1000)+1)*1000; recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl; //Increase to next even thousand
-        }
-        else {
-            maxIterations+=100; recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl;
-        }
-    }
-    if (IsKeyDown(KEY_I)) {
-        if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
-            maxIterations=((maxIterations/1000)-1)*1000; if (maxIterations<2) maxIterations=2;
-            recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl; //Increase to next even thousand
-        }
-        else {
-            maxIterations-=100; if (maxIterations<2) maxIterations=2; recalcSamePoints=true; cout<<"Decreasing Max Iter to "<<maxIterations<<endl;
-        }
-    }
-    if (IsKeyPressed(KEY_P)) pauseCalc=!pauseCalc;
-    if (IsKeyPressed(KEY_C)) highlightCenterOfScreen=!highlightCenterOfScreen;
-    if (IsKeyPressed(KEY_G)) showGrid=!showGrid;
-    if (IsKeyDown(KEY_R)) {
-        cout<<"Reverting to previous center of x:"<<oldCoordCenter_first_float.real<<" y:"<<oldCoordCenter_first_float.imag<<endl;
-        coordCenter_first_float=oldCoordCenter_first_float;
-        coordCenter_second_float=oldCoordCenter_second_float;
-        coordCenter_third_float=oldCoordCenter_third_float;
-        doNewCalc=true;
-    }
-    if (IsKeyDown(KEY_ONE)) displayScreen=1;
-    if (IsKeyDown(KEY_TWO)) displayScreen=2;
-    if (IsKeyDown(KEY_THREE)) displayScreen=3;
-    if (IsKeyDown(KEY_FOUR)) { calcDifference=true; pauseCalc=true; displayScreen=4; } // Second - first
-    if (IsKeyDown(KEY_FIVE)) { calcDifference=true; pauseCalc=true; displayScreen=5; } // Third - first
-    if (IsKeyDown(KEY_SIX)) { calcDifference=true; pauseCalc=true; displayScreen=6; }  // Third - second
-    if (IsKeyDown(KEY_U)) { pauseCalc=false; displayScreen=1; }  //Unpause
-    if (IsKeyDown(KEY_D)) { //Reprint type data
-        cout<<"Limits of types:"<<endl;
-        cout<<"1st float type:\n\tRadix digits: "<<std::numeric_limits<first_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<first_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<first_float>::epsilon()<<"\tmin: "<<std::numeric_limits<first_float>::min()<<"\tMin exponent: "<<std::numeric_limits<first_float>::min_exponent<<"\n\n";
-        cout<<"2nd float type:\n\tRadix digits: "<<std::numeric_limits<second_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<second_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<second_float>::epsilon()<<"\tmin: "<<std::numeric_limits<second_float>::min()<<"\tMin exponent: "<<std::numeric_limits<second_float>::min_exponent<<"\n\n";
-        cout<<"3rd float type:\n\tRadix digits: "<<std::numeric_limits<third_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<third_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<third_float>::epsilon()<<"\tmin: "<<std::numeric_limits<third_float>::min()<<"\tMin exponent: "<<std::numeric_limits<third_float>::min_exponent<<"\n\n";
-        cout<<"Iteration difference type: Base 10 digits: "<<std::numeric_limits<int>::digits10<<" Max: "<<(int)std::numeric_limits<int>::max()<<endl;
-    }
-
-    //If we have changed the center point or zoomed in, recalculate PointToCalc for all 3x1024x1024 pixels, which is slow.  We also reset all pointers and stats.
-    if (doNewCalc) {
-        cout<<"Waiting for old threads to finish..."<<std::flush;
-        for (unsigned int t=0;t<numThreads;t++) {
-            if (futures_first_float[t].valid()) futures_first_float[t].get();
-            if (futures_second_float[t].valid()) futures_second_float[t].get();
-            if (futures_third_float[t].valid()) futures_third_float[t].get();
-        }
-        cout<<"Threads terminated."<<endl;
-        cout<<"Resetting points to plot... "<<std::flush;
-        eraseScreen=true;
-        for (gridPos.y=0;gridPos.y<1024;gridPos.y++) {
-            for (gridPos.x=0;gridPos.x<1024;gridPos.x++) {
-                pointsToCalc_first_float[1024*gridPos.y+gridPos.x].gridPos=gridPos;
-                pointsToCalc_first_float[1024*gridPos.y+gridPos.x].coord=Grid2Coord_first_float(gridPos,coordCenter_first_float,zoomDenomPower);
-                pointsToCalc_first_float[1024*gridPos.y+gridPos.x].iterations=0;
-
-                pointsToCalc_second_float[1024*gridPos.y+gridPos.x].gridPos=gridPos;
-                pointsToCalc_second_float[1024*gridPos.y+gridPos.x].iterations=0;
-                pointsToCalc_third_float[1024*gridPos.y+gridPos.x].iterations=0;
-                pointsToCalc_third_float[1024*gridPos.y+gridPos.x].gridPos=gridPos;
-
-                // OPTION: Change these sets of statements to match initialization routine! (See note above)
-                pointsToCalc_second_float[1024*gridPos.y+gridPos.x].coord=Grid2Coord_second_float(gridPos,coordCenter_second_float,zoomDenomPower);  // Calculate second type's starting point using second type's precision
-                //pointsToCalc_second_float[1024*gridPos.y+gridPos.x].coord=MyComplex_second_float(Grid2Coord_first_float(gridPos,coordCenter_first_float,zoomDenomPower));  // Second type's starting point casts first type's result
-                pointsToCalc_third_float[1024*gridPos.y+gridPos.x].coord=Grid2Coord_third_float(gridPos,coordCenter_third_float,zoomDenomPower);  // Calculate third type's starting point using third type's precision
-                //pointsToCalc_third_float[1024*gridPos.y+gridPos.x].coord=MyComplex_third_float(Grid2Coord_first_float(gridPos,coordCenter_first_float,zoomDenomPower));  // Third type's starting point casts first type's result
-            }
-        }
-        doNewCalc=false;
-        cout<<"done."<<endl;
-        numPointsToCalc=pointsToCalc_first_float.size()+pointsToCalc_second_float.size()+pointsToCalc_third_float.size();
-        numPointsFinished=0;
-        numPointsUpdated=0;
-        batchIter_first_float.startIter=pointsToCalc_first_float.begin();
-        batchIter_first_float.endIter=pointsToCalc_first_float.begin(); //Thus because the next available future will start at last batchIter.endIter and go batchSize further
-        drawIter_first_float.startIter=pointsToCalc_first_float.begin();
-        drawIter_first_float.endIter=pointsToCalc_first_float.begin();
-
-        batchIter_second_float.startIter=pointsToCalc_second_float.begin();
-        batchIter_second_float.endIter=pointsToCalc_second_float.begin();
-        drawIter_second_float.startIter=pointsToCalc_second_float.begin();
-        drawIter_second_float.endIter=pointsToCalc_second_float.begin();
-
-        batchIter_third_float.startIter=pointsToCalc_third_float.begin();
-        batchIter_third_float.endIter=pointsToCalc_third_float.begin();
-        drawIter_third_float.startIter=pointsToCalc_third_float.begin();
-        drawIter_third_float.endIter=pointsToCalc_third_float.begin();
-
-        rangesToDraw_first_float.clear();
-        rangesToDraw_second_float.clear();
-        rangesToDraw_third_float.clear();
-    } //End-if doNewCalc
-
-    //When we simply increase or decrease iterations, just overwrite the iteration values of existing PointToCalc without recomputing the complex plane coordinates associated with each pixel, since these have not changed
-    //Resets our pointers and stats but saves the time-consuming calculation of C for 3x1024x1024 pixels
-    if (recalcSamePoints) {
-        cout<<"Waiting for old threads to finish..."<<std::flush;
-        for (unsigned int t=0;t<numThreads;t++) {
-            if (futures_first_float[t].valid()) futures_first_float[t].get();
-            if (futures_second_float[t].valid()) futures_second_float[t].get();
-            if (futures_third_float[t].valid()) futures_third_float[t].get();
-        }
-        cout<<"Threads terminated."<<endl;
-        cout<<"Points to plot have been reset."<<std::endl;
-
-        recalcSamePoints=false;
-        numPointsToCalc=pointsToCalc_first_float.size()+pointsToCalc_second_float.size()+pointsToCalc_third_float.size();
-        numPointsFinished=0;
-        numPointsUpdated=0;
-        batchIter_first_float.startIter=pointsToCalc_first_float.begin();
-        batchIter_first_float.endIter=pointsToCalc_first_float.begin();
-        drawIter_first_float.startIter=pointsToCalc_first_float.begin();
-        drawIter_first_float.endIter=pointsToCalc_first_float.begin();
-
-        batchIter_second_float.startIter=pointsToCalc_second_float.begin();
-        batchIter_second_float.endIter=pointsToCalc_second_float.begin();
-        drawIter_second_float.startIter=pointsToCalc_second_float.begin();
-        drawIter_second_float.endIter=pointsToCalc_second_float.begin();
-
-        batchIter_third_float.startIter=pointsToCalc_third_float.begin();
-        batchIter_third_float.endIter=pointsToCalc_third_float.begin();
-        drawIter_third_float.startIter=pointsToCalc_third_float.begin();
-        drawIter_third_float.endIter=pointsToCalc_third_float.begin();
-
-        rangesToDraw_first_float.clear();
-        rangesToDraw_second_float.clear();
-        rangesToDraw_third_float.clear();
-    } //End-if recalcSamePoints
-
-    //Plots trajectories for a single point using three different float types.  For display screen modes 7 and 8.
-    if (drawThreePaths) {
-        pathPoints_first_float.clear();
-        pathPoints_second_float.clear();
-        pathPoints_third_float.clear();
-        pathPoints_first_float=msetPath_first_float(firstPathPoint_first_float, maxIterations);
-        pathPoints_second_float=msetPath_second_float(firstPathPoint_second_float, maxIterations);
-        pathPoints_third_float=msetPath_third_float(firstPathPoint_third_float, maxIterations);
-
-        cout<<"Coordinates:\nFirst float:"<<firstPathPoint_first_float<<endl;
-        cout<<"Second float:"<<firstPathPoint_second_float<<endl;
-        cout<<"Third float:"<<firstPathPoint_third_float<<endl;
-        cout<<"Iterations: 1st: "<<pathPoints_first_float.size()<<" 2nd: "<<pathPoints_second_float.size()<<" 3rd: "<<pathPoints_third_float.size()<<endl;
-
-        BeginTextureMode(pathDrawings);
-        ClearBackground(BLANK);
-        unsigned int pathsize=pathPoints_first_float.size();
-        for (unsigned int i=0;i<pathsize-1;i++) {
-            DrawLine(pathPoints_first_float[i].x,pathPoints_first_float[i].y,pathPoints_first_float[i+1].x,pathPoints_first_float[i+1].y,BLUE);
-            DrawLine(pathPoints_second_float[i].x,pathPoints_second_float[i].y,pathPoints_second_float[i+1].x,pathPoints_second_float[i+1].y,RED);
-            DrawLine(pathPoints_third_float[i].x,pathPoints_third_float[i].y,pathPoints_third_float[i+1].x,pathPoints_third_float[i+1].y,YELLOW);
-        }
-        DrawLine(pathPoints_first_float[pathsize-2].x,pathPoints_first_float[pathsize-2].y,pathPoints_first_float[pathsize-1].x,pathPoints_first_float[pathsize-1].y,BLUE);
-        DrawLine(pathPoints_second_float[pathsize-2].x,pathPoints_second_float[pathsize-2].y,pathPoints_second_float[pathsize-1].x,pathPoints_second_float[pathsize-1].y,RED);
-        DrawLine(pathPoints_third_float[pathsize-2].x,pathPoints_third_float[pathsize-2].y,pathPoints_third_float[pathsize-1].x,pathPoints_third_float[pathsize-1].y,YELLOW);
-        EndTextureMode();
-        drawThreePaths=false;
-    } //End-if drawThreePaths
-
-    //Calculates the difference between iteration values obtained for each floating point type.  Calculates basic stats about the differences.
-    if (calcDifference) {
-        int pixeldiff=0;
-        int pixeldiff_min=0;
-        int pixeldiff_max=0;
-        int pixeldiffCounter=0;
-
-        if ( (displayScreen==4) || (displayScreen==7) ) {
-            BeginTextureMode(diffScreen2M1);
-            for (unsigned int i=0;i<1024*1024;i++) {
-                pixeldiff=pointsToCalc_second_float[i].iterations-pointsToCalc_first_float[i].iterations;
-                if (pixeldiff==0) {
-                    differentPixels2M1[i]=0;
-                    DrawPixel(i%1024,i/1024,BLACK);
-                }
-                else {
-                    pixeldiffCounter++;
-                    if (pixeldiff>pixeldiff_max) pixeldiff_max=pixeldiff;
-                    if (pixeldiff<pixeldiff_min) pixeldiff_min=pixeldiff;
-                    differentPixels2M1[i]=pixeldiff;
-                    DrawPixel(i%1024,i/1024,colorizePixelDiff(pixeldiff));
-                }
-            }
-            EndTextureMode();
-            calcDifference=false;
-            cout<<"Difference stats of Second type - First type:\nDifferent pixels: "<<pixeldiffCounter<<" ("<<(float)pixeldiffCounter/(10.24f*1024.0f)<<"%)\nMax diff: "<<pixeldiff_max<<" Min diff: "<<pixeldiff_min<<endl;
-        }
-
-        else if (displayScreen==5) {
-            BeginTextureMode(diffScreen3M1);
-            for (unsigned int i=0;i<1024*1024;i++) {
-                pixeldiff=pointsToCalc_third_float[i].iterations-pointsToCalc_first_float[i].iterations;
-                if (pixeldiff==0) {
-                    differentPixels3M1[i]=0;
-                    DrawPixel(i%1024,i/1024,BLACK);
-                }
-                else {
-                    pixeldiffCounter++;
-                    if (pixeldiff>pixeldiff_max) pixeldiff_max=pixeldiff;
-                    if (pixeldiff<pixeldiff_min) pixeldiff_min=pixeldiff;
-                    differentPixels3M1[i]=pixeldiff;
-                    DrawPixel(i%1024,i/1024,colorizePixelDiff(pixeldiff));
-                }
-            }
-            EndTextureMode();
-            calcDifference=false;
-            cout<<"Difference stats of Third type - First type:\nDifferent pixels: "<<pixeldiffCounter<<" ("<<(float)pixeldiffCounter/(10.24f*1024.0f)<<"%)\nMax diff: "<<pixeldiff_max<<" Min diff: "<<pixeldiff_min<<endl;
-        }
-
-        else if (displayScreen==6) {
-            BeginTextureMode(diffScreen3M2);
-            for (unsigned int i=0;i<1024*1024;i++) {
-                pixeldiff=pointsToCalc_third_float[i].iterations-pointsToCalc_second_float[i].iterations;
-                if (pixeldiff==0) {
-                    differentPixels3M2[i]=0;
-                    DrawPixel(i%1024,i/1024,BLACK);
-                }
-                else {
-                    pixeldiffCounter++;
-                    if (pixeldiff>pixeldiff_max) pixeldiff_max=pixeldiff;
-                    if (pixeldiff<pixeldiff_min) pixeldiff_min=pixeldiff;
-                    differentPixels3M2[i]=pixeldiff;
-                    DrawPixel(i%1024,i/1024,colorizePixelDiff(pixeldiff));
-                }
-            }
-            EndTextureMode();
-            calcDifference=false;
-            cout<<"Difference stats of Third type - Second type:\nDifferent pixels: "<<pixeldiffCounter<<" ("<<(float)pixeldiffCounter/(10.24f*1024.0f)<<"%)\nMax diff: "<<pixeldiff_max<<" Min diff: "<<pixeldiff_min<<endl;
-        }
-        else if ((displayScreen==1) || (displayScreen==7)||(displayScreen==8)) {
-            //Do nothing
-        }
-        else {
-            //Error -- how did we get here?
-            cerr<<"Error in difference screen logic.  Display screen mode="<<displayScreen<<endl;
-            calcDifference=false;
-            displayScreen=1;
-        }
-    } // End-if calcDifference
-
-    // The main routine which assigns new work to threads and fetches completed work
-    if (!pauseCalc) {
-        //For our first type's numThreads threads:
-        for (unsigned int t=0; t<numThreads; t++) {  //For each thread
-            if (futures_first_float[t].valid()) {  //If there's a valid future, that means work has been assigned
-                if (futures_first_float[t].wait_for(0s)==future_status::ready) {  //See if it's ready yet
-                    drawIter_first_float=futures_first_float[t].get();  // If ready, get the range of points that has been completed.  (Iterations values have been updated directly since this operation is thread-safe.)
-                    rangesToDraw_first_float.push_back(drawIter_first_float);  // Push the range of newly-computed points to the vector to draw them in the next update
-                    if (batchIter_first_float.endIter<pointsToCalc_first_float.end()) {  // If there is more work to do, assign it to this now-idle thread
-                        batchIter_first_float.startIter=batchIter_first_float.endIter;
-                        batchIter_first_float.endIter=(batchIter_first_float.startIter+batchSize_first_float>pointsToCalc_first_float.end())?pointsToCalc_first_float.end():batchIter_first_float.startIter+batchSize_first_float;
-                        futures_first_float[t]=std::async(msetBatch_first_float,batchIter_first_float,maxIterations);
-                    }
-                }
-            }
-            else {  // If there isn't a valid future, that's because we are either out of new work to assign, or we have just reset our points to calculate and terminated all previously-running threads
-                if (batchIter_first_float.endIter<pointsToCalc_first_float.end()) {  //If the latter, assign new work as above
-                    batchIter_first_float.startIter=batchIter_first_float.endIter;
-                    batchIter_first_float.endIter=(batchIter_first_float.startIter+batchSize_first_float>pointsToCalc_first_float.end())?pointsToCalc_first_float.end():batchIter_first_float.startIter+batchSize_first_float;
-                    futures_first_float[t]=std::async(msetBatch_first_float,batchIter_first_float,maxIterations);
-                }
-            }
-        }
-
-        //Do the same thing as above for our second type's threads
-        for (unsigned int t=0; t<numThreads; t++) {
-            if (futures_second_float[t].valid()) {
-                if (futures_second_float[t].wait_for(0s)==future_status::ready) {
-                    drawIter_second_float=futures_second_float[t].get();
-                    rangesToDraw_second_float.push_back(drawIter_second_float);
-                    if (batchIter_second_float.endIter<pointsToCalc_second_float.end()) {
-                        batchIter_second_float.startIter=batchIter_second_float.endIter;
-                        batchIter_second_float.endIter=(batchIter_second_float.startIter+batchSize_second_float>pointsToCalc_second_float.end())?pointsToCalc_second_float.end():batchIter_second_float.startIter+batchSize_second_float;
-                        futures_second_float[t]=std::async(msetBatch_second_float,batchIter_second_float,maxIterations);
-                    }
-                }
-            }
-            else {
-                if (batchIter_second_float.endIter<pointsToCalc_second_float.end()) {
-                    batchIter_second_float.startIter=batchIter_second_float.endIter;
-                    batchIter_second_float.endIter=(batchIter_second_float.startIter+batchSize_second_float>pointsToCalc_second_float.end())?pointsToCalc_second_float.end():batchIter_second_float.startIter+batchSize_second_float;
-                    futures_second_float[t]=std::async(msetBatch_second_float,batchIter_second_float,maxIterations);
-                }
-            }
-        }
-
-        //Do the same thing for our third type's threads
-        for (unsigned int t=0; t<numThreads; t++) {
-            if (futures_third_float[t].valid()) {
-                if (futures_third_float[t].wait_for(0s)==future_status::ready) {
-                    drawIter_third_float=futures_third_float[t].get();
-                    rangesToDraw_third_float.push_back(drawIter_third_float);
-                    if (batchIter_third_float.endIter<pointsToCalc_third_float.end()) {
-                        batchIter_third_float.startIter=batchIter_third_float.endIter;
-                        batchIter_third_float.endIter=(batchIter_third_float.startIter+batchSize_third_float>pointsToCalc_third_float.end())?pointsToCalc_third_float.end():batchIter_third_float.startIter+batchSize_third_float;
-                        futures_third_float[t]=std::async(msetBatch_third_float,batchIter_third_float,maxIterations);
-                    }
-                }
-            }
-            else {
-                if (batchIter_third_float.endIter<pointsToCalc_third_float.end()) {
-                    batchIter_third_float.startIter=batchIter_third_float.endIter;
-                    batchIter_third_float.endIter=(batchIter_third_float.startIter+batchSize_third_float>pointsToCalc_third_float.end())?pointsToCalc_third_float.end():batchIter_third_float.startIter+batchSize_third_float;
-                    futures_third_float[t]=std::async(msetBatch_third_float,batchIter_third_float,maxIterations);
-                }
-            }
-        }
-
-    } //End-if !pauseCalc
-
-
-    //Update RenderTextures.  We also update our progress stats here.
-    numPointsUpdated=0;
-
-    //For our first type
-    BeginTextureMode(msetRenderTexture_first_float); //Update image for first type
-    if (eraseScreen) {
-        ClearBackground(BLACK); //We only toggle eraseScreen after erasing the third type's screen further below
-    }
-    for (unsigned int i=0;i<rangesToDraw_first_float.size();i++) {  //Plot points for ranges of iterators returned above in (!pauseCalc) routine
-        for (vector<PointToCalc_first_float>::iterator it=rangesToDraw_first_float[i].startIter;it!=rangesToDraw_first_float[i].endIter;it++) {
-            DrawPixel(it->gridPos.x,it->gridPos.y,colorizer(it->iterations));
-        }
-        numPointsUpdated+=(unsigned int)(rangesToDraw_first_float[i].endIter-rangesToDraw_first_float[i].startIter);  //Update stats
-    }
-    EndTextureMode();
-    rangesToDraw_first_float.clear(); // Clear vector since these points have been plotted now
-
-    //Same for our second type
-    BeginTextureMode(msetRenderTexture_second_float);
-    if (eraseScreen) {
-        ClearBackground(BLACK);
-    }
-    for (unsigned int i=0;i<rangesToDraw_second_float.size();i++) {
-        for (vector<PointToCalc_second_float>::iterator it=rangesToDraw_second_float[i].startIter;it!=rangesToDraw_second_float[i].endIter;it++) {
-            DrawPixel(it->gridPos.x,it->gridPos.y,colorizer(it->iterations));
-        }
-        numPointsUpdated+=(unsigned int)(rangesToDraw_second_float[i].endIter-rangesToDraw_second_float[i].startIter);
-    }
-    EndTextureMode();
-    rangesToDraw_second_float.clear();
-
-    //Same for our third type
-    BeginTextureMode(msetRenderTexture_third_float);
-    if (eraseScreen) {
-        ClearBackground(BLACK);
-        eraseScreen=false;
-    }
-    for (unsigned int i=0;i<rangesToDraw_third_float.size();i++) {
-        for (vector<PointToCalc_third_float>::iterator it=rangesToDraw_third_float[i].startIter;it!=rangesToDraw_third_float[i].endIter;it++) {
-            DrawPixel(it->gridPos.x,it->gridPos.y,colorizer(it->iterations));
-        }
-        numPointsUpdated+=(unsigned int)(rangesToDraw_third_float[i].endIter-rangesToDraw_third_float[i].startIter);
-    }
-    EndTextureMode();
-    rangesToDraw_third_float.clear();
-
-    //Update the other stats now that we know how many points we have plotted for all three types
-    numPointsFinished+=numPointsUpdated;
-    numPointsToCalc-=numPointsUpdated;
-
-    //Draw everything to the screen
-    BeginDrawing();
-    ClearBackground(BLACK);
-    DrawFPS(1030,5);
-
-    //Compose what we draw according to the display screen mode selected
-    if (displayScreen==1) {
-        DrawTextureRec(msetRenderTexture_first_float.texture,flipRec,origin,WHITE);
-        //Draw small rectangle to indicate progress
-        if (batchIter_first_float.endIter!=pointsToCalc_first_float.end()) {
-            DrawRectangle(batchIter_first_float.startIter->gridPos.x,batchIter_first_float.startIter->gridPos.y,3,3,Fade(WHITE,0.8));
-        }
-        DrawText("First type",1030,50,20,WHITE);
-    }
-    if (displayScreen==2) {
-        DrawTextureRec(msetRenderTexture_second_float.texture,flipRec,origin,WHITE);
-        //Draw small rectangle to indicate progress
-        if (batchIter_second_float.endIter!=pointsToCalc_second_float.end()) {
-            DrawRectangle(batchIter_second_float.startIter->gridPos.x,batchIter_second_float.startIter->gridPos.y,3,3,Fade(WHITE,0.8));
-        }
-        DrawText("Second type",1030,50,20,WHITE);
-    }
-    if (displayScreen==3) {
-        DrawTextureRec(msetRenderTexture_third_float.texture,flipRec,origin,WHITE);
-        //Draw small rectangle to indicate progress
-        if (batchIter_third_float.endIter!=pointsToCalc_third_float.end()) {
-            DrawRectangle(batchIter_third_float.startIter->gridPos.x,batchIter_third_float.startIter->gridPos.y,3,3,Fade(WHITE,0.8));
-        }
-        DrawText("Third type",1030,50,20,WHITE);
-    }
-    if (displayScreen==4) {
-        DrawTextureRec(diffScreen2M1.texture,flipRec,origin,WHITE);
-        DrawText("Difference",1030,50,20,WHITE);
-        DrawText("Type 2 - Type 1",1035,80,16,WHITE);
-    }
-    if (displayScreen==5) {
-        DrawTextureRec(diffScreen3M1.texture,flipRec,origin,WHITE);
-        DrawText("Difference",1030,50,20,WHITE);
-        DrawText("Type 3 - Type 1",1035,80,16,WHITE);
-    }
-    if (displayScreen==6) {
-        DrawTextureRec(diffScreen3M2.texture,flipRec,origin,WHITE);
-        DrawText("Difference",1030,50,20,WHITE);
-        DrawText("Type 3 - Type 2",1035,80,16,WHITE);
-    }
-    if (displayScreen==7) {
-        DrawTexturePro(msetRenderTexture_first_float.texture,flipRec,{0.0,0.0,512.0f,512.0f},origin,0,WHITE);
-        DrawTexturePro(msetRenderTexture_second_float.texture,flipRec,{512.0,0.0,512.0f,512.0f},origin,0,WHITE);
-        DrawTexturePro(diffScreen2M1.texture,flipRec,{0.0,512.0,512.0f,512.0f},origin,0,WHITE);
-        DrawTexturePro(msetCanvas.texture,flipRec,{512.0,512.0,512.0f,512.0f},origin,0,Fade(WHITE,0.5));
-        DrawTexturePro(pathDrawings.texture,flipRec,{512.0,512.0,512.0f,512.0f},origin,0,WHITE);
-    }
-    if (displayScreen==8) {
-        //DrawTextureRec(msetCanvas.texture,flipRec,origin,Fade(WHITE,0.5));
-        DrawTextureRec(msetRenderTexture_first_float.texture,flipRec,origin,WHITE);
-        DrawTextureRec(pathDrawings.texture,flipRec,origin,WHITE);
-    }
-
-    //Draws a small rectangle to indicate the exact center of the screen.  Useful for zooming.
-    if (highlightCenterOfScreen) DrawRectangle(511,511,3,3,Fade(WHITE,0.8));
-
-    if (showGrid) { // To help estimate orbit positions on the screen and for estimating zoom by factors of two or eight
-        DrawCircleLines(512,512,64,Fade(GRAY,0.5));  //Circles at radius 1/4, 1/2, 3/4 and 1
-        DrawCircleLines(512,512,128,Fade(GRAY,0.5));
-        DrawCircleLines(512,512,192,Fade(GRAY,0.5));
-        DrawCircleLines(512,512,256,Fade(LIGHTGRAY,0.5));
-        DrawRectangleLines(256,256,512,512,Fade(LIGHTGRAY,0.5)); // Rectangle from (-1,-1) to (1,1)
-        DrawCircleLines(512,512,512,Fade(GRAY,0.5));
-        DrawLine(0,0,1023,1023,Fade(GRAY,0.5));
-        DrawLine(0,1023,1023,0,Fade(GRAY,0.5));
-    }
-
-    //Update sidebar info
-    DrawText("Max iterations:",1030,650,20,WHITE);
-    DrawText(PrintNum(smallText,maxIterations),1035,680,20,WHITE);
-
-    DrawText("Pixel delta is",1030,710,20,WHITE);
-    snprintf(smallText,40,"2^%i",zoomDenomPower);
-    DrawText(smallText,1035,740,20,WHITE);
-
-    if (pauseCalc) DrawText("Paused.",1030,770,20,YELLOW);
-
-    DrawText("Points Finished:",1030,800,20,GREEN);
-    DrawText(PrintNum(smallText,numPointsFinished),1035,830,20,GREEN);
-    DrawText("Updated:",1030,860,20,GREEN);
-    DrawText(PrintNum(smallText,numPointsUpdated),1035,890,20,GREEN);
-    DrawText("Remaining:",1030,920,20,GREEN);
-    DrawText(PrintNum(smallText,numPointsToCalc),1035,950,20,GREEN);
-
-    EndDrawing();
-
-    } //End main loop white
-
-    //Clean-up.  RayLib requires that we unload all textures.
-    UnloadRenderTexture(msetRenderTexture_first_float);
-    UnloadRenderTexture(msetRenderTexture_second_float);
-    UnloadRenderTexture(msetRenderTexture_third_float);
-    UnloadRenderTexture(diffScreen2M1);
-    UnloadRenderTexture(diffScreen3M1);
-    UnloadRenderTexture(diffScreen3M2);
-    UnloadRenderTexture(pathDrawings);
-    UnloadRenderTexture(msetCanvas);
-    CloseWindow();
-    return 0;
-}
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <limits>
+
+#include "raylib.h"
+#include "msetCore.hpp"
+#include "msetThreadPool.hpp"
+#include "msetSimd.hpp"
+#include "msetPerturbation.hpp"
+#include "msetMarianiSilver.hpp"
+#include "msetProgressive.hpp"
+#include "msetTrace.hpp"
+#include "msetScheduler.hpp"
+#include "msetTiles.hpp"
+#include "msetFramebuffer.hpp"
+#include "msetDifference.hpp"
+
+using namespace std;
+
+inline bool mouseIsInBounds(Vector2 m) {
+    return ( (m.x>1)&&(m.x<1024)&&(m.y>1)&&(m.y<1024) );
+}
+
+//TODO: Get a more attractive palette function
+//Iterations-to-color for main image.  Repeats every 16384 iterations, which iterationColors in main() relies on to make a table of it.
+Color colorizer(int iter) {
+    if (iter<=0) return BLACK;
+    Color c;
+    c.a=255;
+    c.r=64+12*(iter%16);
+    c.g=8*((iter/16)%32);
+    c.b=16*((iter/512)%32);
+return c;
+}
+
+//Returns color used when subtracting two images, using only red, green and black.  Repeats every 4 (see diffColors in main()).
+Color colorizePixelDiff(int i) {
+    Color c=BLACK;
+    if (i>0) {
+        c.g=(unsigned char)(128+31*(i%4));
+    }
+    if (i<0) {
+        i=-i;
+        c.r=(unsigned char)(128+31*(i%4));;
+    }
+return c;
+}
+
+//For raylib DrawText function
+char* PrintNum(char* c, int n) {
+    snprintf(c,10,"%i",n);
+return c;
+}
+
+//Checks the coords of the points whose results were moved across the grid (ShiftPoints, ZoomPoints) against the store's new view, so that no rounding
+//accumulates from one move to the next.  Results are only kept where keep is set and the new coord is exactly the one they were computed for: always at shallow
+//zooms, but not once the type runs out of digits.  The rest are left pending for the kernels.  Returns the ranges of points left to compute.
+template<class StoreType>
+vector<IndexRange> RebuildCoords(StoreType &points, const vector<char> &keep) {
+    vector<IndexRange> ranges;
+    for (size_t i=0;i<points.Size();i++) {
+        if (keep[i] && !points.coordPending[i]) {
+            auto coord=points.CoordAt(points.GridPos(i));
+            if ( (coord.real==points.coordReal[i]) && (coord.imag==points.coordImag[i]) ) continue;
+        }
+        points.iterations[i]=0;
+        points.coordPending[i]=1;
+        if (!ranges.empty() && (ranges.back().end==i)) ranges.back().end++;
+        else ranges.push_back({i,i+1});
+    }
+return ranges;
+}
+
+//For recentering by a whole number of pixels at the same zoom.  Moves every point's results so that the point now at (x,y) holds those of the old (x+dx,y+dy).
+//Call after SetView.
+template<class StoreType>
+vector<IndexRange> ShiftPoints(StoreType &points, int res, int dx, int dy) {
+    vector<char> keep(points.Size(),0);
+    long long shift=(long long)dy*res+dx;  //Index offset from a point to the one whose results it takes
+    long long n=(long long)points.Size();
+    for (long long k=0;k<n;k++) {
+        long long i=(shift>0)?k:n-1-k;  //Walk away from the sources, like memmove, so none is overwritten before it is read
+        int sx=(int)(i%res)+dx, sy=(int)(i/res)+dy;
+        if ((sx<0)||(sx>=res)||(sy<0)||(sy>=res)) continue;
+        points.CopyPoint(i,points,i+shift);
+        keep[i]=1;
+    }
+return RebuildCoords(points,keep);
+}
+
+//For zooming by a power of two about the center: in by 2^step, or out by 2^-step.  Zooming in, the points a multiple of 2^step pixels from the center land
+//exactly on old points; zooming out, every point within the old view does.  Those take the old results and the rest are left to compute.
+template<class StoreType>
+vector<IndexRange> ZoomPoints(StoreType &points, int res, int step) {
+    vector<char> keep(points.Size(),0);
+    vector<size_t> targets, sources;
+    int half=res/2, factor=1<<abs(step);
+    for (size_t i=0;i<points.Size();i++) {
+        int ox=(int)(i%res)-half, oy=(int)(i/res)-half;
+        int sx, sy;
+        if (step>0) {
+            if ((ox%factor!=0)||(oy%factor!=0)) continue;
+            sx=half+ox/factor; sy=half+oy/factor;
+        }
+        else {
+            sx=half+ox*factor; sy=half+oy*factor;
+            if ((sx<0)||(sx>=res)||(sy<0)||(sy>=res)) continue;
+        }
+        targets.push_back(i);
+        sources.push_back((size_t)res*sy+sx);
+    }
+    StoreType moved;  //Copies of the old points, taken before any is overwritten
+    moved.Gather(points,sources);
+    for (size_t j=0;j<targets.size();j++) {
+        points.CopyPoint(targets[j],moved,j);
+        keep[targets[j]]=1;
+    }
+return RebuildCoords(points,keep);
+}
+
+//Colors the points outside ranges, i.e. those whose results were carried over by ZoomPoints
+template<class StoreType>
+void PaintPointsOutside(Framebuffer<Color> &image, const StoreType &points, const vector<IndexRange> &ranges, const PaletteTable<Color> &palette) {
+    size_t i=0;
+    for (const IndexRange &r:ranges) {
+        PaintRange(image,points,{i,r.start},palette);
+        i=r.end;
+    }
+    PaintRange(image,points,{i,points.Size()},palette);
+}
+
+int main()
+{
+    //Names this thread's trace ring, which is registered by the first event it records (see msetTrace.hpp)
+    MSET_TRACE_THREAD_NAME("UI");
+
+    Vector2 mousePos;
+    unsigned int zoomDenomPower=8;
+    unsigned int pointsZoomDenomPower=zoomDenomPower;
+    MyComplex_first_float coordCenter_first_float;
+    MyComplex_second_float coordCenter_second_float;
+    MyComplex_third_float coordCenter_third_float;
+    MyComplex_first_float oldCoordCenter_first_float;
+    MyComplex_second_float oldCoordCenter_second_float;
+    MyComplex_third_float oldCoordCenter_third_float;
+    int maxIterations=100;
+    bool doNewCalc=false;
+    bool doPan=false;  //Recentered by panShift pixels at the same zoom
+    bool doZoom=false;  //zoomDenomPower changed from pointsZoomDenomPower, the zoom the point lists were built for, with the center unchanged
+    int_vector2 panShift={0,0};
+    bool recalcSamePoints=false;
+    bool resetOrbits=false;  //With recalcSamePoints: iterate every point from z=0 instead of resuming, e.g. after a setting that changes which points are known interior
+    bool pauseCalc=false;
+    bool highlightCenterOfScreen=false;
+    bool showGrid=false;
+    bool printDifference=false;
+    bool drawThreePaths=false;
+    char smallText[40];
+    unsigned int displayScreen=1;
+
+    // OPTION: Number of worker threads, shared by all three types.  0 means one per hardware thread (std::thread::hardware_concurrency()).
+    unsigned int numThreads=0;
+
+    // OPTION: Batch size for the three types until the scheduler has measured their cost, after which it sizes batches to take about
+    // scheduler.targetBatchSeconds (see msetScheduler.hpp).
+    unsigned int batchSize_first_float=10240;
+    unsigned int batchSize_second_float=5120;
+    unsigned int batchSize_third_float=1024;
+
+    // OPTION: Use the AVX2/AVX-512 kernel for any type that is double, if the CPU supports it.  Gives the same iteration counts as the scalar kernel.
+    bool useSimdKernel=true;
+    if (!useSimdKernel) LimitSimdLevel(simdScalar);
+
+    // OPTION: Render the second and third types by perturbation: one reference orbit at the view center in the type's own precision, every pixel iterating only
+    // its offset from it in double.  Much faster at deep zooms.  Toggle at runtime with X.  See msetPerturbation.hpp.
+    bool usePerturbation_second_float=false;
+    bool usePerturbation_third_float=false;
+
+    // OPTION: Stop iterating points whose orbit has settled into a cycle, since they are inside the set.  Toggle at runtime with Y.  See PeriodicityCheckEnabled() in msetCore.hpp.
+    PeriodicityCheckEnabled()=true;
+    SetPeriodicityTolerance(zoomDenomPower);
+
+    // OPTION: Mark points in the main cardioid, the period-2 bulb and a few other large bulbs as interior without iterating them.  See InteriorTestEnabled() in msetCore.hpp.
+    InteriorTestEnabled()=true;
+
+    // OPTION: Number of terms in the series approximation that lets perturbation-rendered pixels skip their first iterations.  0 turns it off.
+    int seriesOrder=8;
+
+    // OPTION: Render a type by Mariani-Silver subdivision: iterate rectangle borders and fill rectangles whose border has a single iteration count.  Much faster on
+    // views with large uniform areas, but a fill can hide detail that falls between border pixels, which then shows up in the difference screens.  Toggle the
+    // displayed type at runtime with B.  Perturbation takes precedence for the second and third types.  See msetMarianiSilver.hpp.
+    bool useMarianiSilver_first_float=false;
+    bool useMarianiSilver_second_float=false;
+    bool useMarianiSilver_third_float=false;
+
+    // OPTION: Also iterate every pixel Mariani-Silver fills and count the ones the fill got wrong.  Costs as much as rendering without it.
+    bool verifyMarianiSilver=false;
+
+    // OPTION: Render whole images coarse to fine: every 16th pixel first, shown as blocks, then halving the spacing down to every pixel, detail first.
+    // The finished image is the same.  Applies to all three types except those using Mariani-Silver.  Toggle at runtime with F.  See msetProgressive.hpp.
+    bool useProgressive=false;
+
+    //Initialize stores to hold our points to calculate for each type
+    PointStore_first_float pointsToCalc_first_float(1024);
+    PointStore_second_float pointsToCalc_second_float(1024);
+    PointStore_third_float pointsToCalc_third_float(1024);
+
+    cout<<setprecision(33);
+    //Print our numeric limits for our types
+    cout<<"Limits of types:"<<endl;
+    cout<<"1st float type:\n\tRadix digits: "<<std::numeric_limits<first_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<first_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<first_float>::epsilon()<<"\tmin: "<<std::numeric_limits<first_float>::min()<<"\tMin exponent: "<<std::numeric_limits<first_float>::min_exponent<<"\n\n";
+    cout<<"2nd float type:\n\tRadix digits: "<<std::numeric_limits<second_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<second_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<second_float>::epsilon()<<"\tmin: "<<std::numeric_limits<second_float>::min()<<"\tMin exponent: "<<std::numeric_limits<second_float>::min_exponent<<"\n\n";
+    cout<<"3rd float type:\n\tRadix digits: "<<std::numeric_limits<third_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<third_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<third_float>::epsilon()<<"\tmin: "<<std::numeric_limits<third_float>::min()<<"\tMin exponent: "<<std::numeric_limits<third_float>::min_exponent<<"\n\n";
+    cout<<"Iteration difference type: Base 10 digits: "<<std::numeric_limits<int>::digits10<<" Max: "<<(int)std::numeric_limits<int>::max()<<endl;
+    cout<<"Kernels: 1st float type "<<SimdLevelName(KernelSimdLevel<first_float>())<<", 2nd "<<SimdLevelName(KernelSimdLevel<second_float>())
+        <<", 3rd "<<SimdLevelName(KernelSimdLevel<third_float>())<<endl;
+
+    //Points every store at the current center and zoom.  Coordinates are only generated as the workers reach each point (see PointStore in msetCore.hpp).
+    auto setPointViews=[&]() {
+        pointsToCalc_first_float.SetView(coordCenter_first_float,zoomDenomPower);
+        pointsToCalc_second_float.SetView(coordCenter_second_float,zoomDenomPower);
+        pointsToCalc_third_float.SetView(coordCenter_third_float,zoomDenomPower);
+    };
+
+    //Initialize first display, the same way as doNewCalc below
+    cout<<"Initializing point list"<<endl;
+    // OPTION: Select whether higher-precision types calculate starting point C (in Z=Z^2+C) using their own precision, or whether they cast the result of the first type's calculation, retaining its more limited precision
+    // Relevant when lower-precision floats lose accuracy with higher zooms.  Casting the value ensures that all three float types start with the same initial value for point C,
+    // and thus any subsequent divergence in iteration value is from accumulated error due to the types themselves and not their slightly different starting values.
+    // Not casting means that all three types may start with slightly different values for C depending on the depth of zoom.
+    // Applies to every view, including after panning and zooming.
+    //pointsToCalc_second_float.castFrom=&pointsToCalc_first_float;  // Second type's starting point casts the first type's result, keeping its more limited precision
+    //pointsToCalc_third_float.castFrom=&pointsToCalc_first_float;  // Third type's starting point casts the first type's result, keeping its more limited precision
+    setPointViews();
+    pointsToCalc_first_float.InvalidateCoords();
+    pointsToCalc_second_float.InvalidateCoords();
+    pointsToCalc_third_float.InvalidateCoords();
+    cout<<setprecision(4)<<"Point store memory: type 1 "<<pointsToCalc_first_float.MemoryBytes()/1048576.0<<" MB, type 2 "<<pointsToCalc_second_float.MemoryBytes()/1048576.0
+        <<" MB, type 3 "<<pointsToCalc_third_float.MemoryBytes()/1048576.0<<" MB"<<setprecision(33)<<endl;
+
+    //drawIter_* hold the most recently completed batch of each type, used for the on-screen progress indicator
+    IndexRange drawIter_first_float={0,0};  //nothing to draw initially
+    IndexRange drawIter_second_float={0,0};
+    IndexRange drawIter_third_float={0,0};
+
+    //Workers push the tiles the scheduler gave them into completedTiles_* as they finish them, already colored into the type's framebuffer, and the index
+    //ranges finished by Mariani-Silver and progressive rendering into completedRanges_*.  Each frame the UI thread moves both to tilesToDraw_* and
+    //rangesToDraw_*, colors the ranges and uploads what changed to the textures.
+    ResultQueue<TileResult> completedTiles_first_float;
+    ResultQueue<TileResult> completedTiles_second_float;
+    ResultQueue<TileResult> completedTiles_third_float;
+    vector<TileResult> tilesToDraw_first_float;
+    vector<TileResult> tilesToDraw_second_float;
+    vector<TileResult> tilesToDraw_third_float;
+    ResultQueue<IndexRange> completedRanges_first_float;
+    ResultQueue<IndexRange> completedRanges_second_float;
+    ResultQueue<IndexRange> completedRanges_third_float;
+    vector<IndexRange> rangesToDraw_first_float;
+    vector<IndexRange> rangesToDraw_second_float;
+    vector<IndexRange> rangesToDraw_third_float;
+
+    //Nonzero while a type has work queued or running that has not been drawn yet: Mariani-Silver or progressive tasks, or points in the scheduler
+    size_t workPending_first_float=0, workPending_second_float=0, workPending_third_float=0;
+
+    //Rebase counts and reference orbit lengths for types rendered by perturbation, for the sidebar
+    PerturbationStats perturbStats_second_float;
+    PerturbationStats perturbStats_third_float;
+
+    //Fill counts for types rendered by Mariani-Silver.  Its rectangles come back as many small ranges, so pending work is tracked by rectsPending instead of workPending_*.
+    MarianiSilverStats msStats_first_float, msStats_second_float, msStats_third_float;
+    bool marianiSilverRunning_first_float=false, marianiSilverRunning_second_float=false, marianiSilverRunning_third_float=false;
+
+    //Same for types rendered progressively, whose pixels are also drawn as blocks until finer levels fill them in
+    ProgressiveStats progressiveStats_first_float, progressiveStats_second_float, progressiveStats_third_float;
+    bool progressiveRunning_first_float=false, progressiveRunning_second_float=false, progressiveRunning_third_float=false;
+
+    //Compute basic stats about the work remaining for on-screen progress display
+    unsigned int numPointsFinished=0, numPointsUpdated=0, numPointsToCalc;
+    numPointsToCalc=pointsToCalc_first_float.Size()+pointsToCalc_second_float.Size()+pointsToCalc_third_float.Size();
+
+    // OPTION: The scheduler hands out work as square tiles of tileSize x tileSize points, a power of two up to 1024, ordered from the center of the screen
+    // outward, or from the mouse cursor if tilesFromMouse is set, so the part you are looking at resolves first.  See msetTiles.hpp.
+    TileGrid tileGrid;
+    tileGrid.tileSize=32;
+    bool tilesFromMouse=false;
+
+    //CPU-side images of the three types, uploaded to their textures a region at a time (see msetFramebuffer.hpp).  Pixels are colored from tables of
+    //colorizer and colorizePixelDiff, whose periods must match the functions.
+    const PaletteTable<Color> iterationColors(colorizer,16384);
+    const PaletteTable<Color> diffColors(colorizePixelDiff,4);
+    Framebuffer<Color> framebuffer_first_float(tileGrid,BLACK);
+    Framebuffer<Color> framebuffer_second_float(tileGrid,BLACK);
+    Framebuffer<Color> framebuffer_third_float(tileGrid,BLACK);
+
+    //Differences of iteration value between the three types, pair 0 = type 2 - type 1, 1 = type 3 - type 1, 2 = type 3 - type 2, with their images for
+    //screens 4-6 and statistics, kept up to date as points finish (see msetDifference.hpp)
+    DifferenceMaps<Color> differences(tileGrid,diffColors);
+    const char *differenceNames[3]={"Second type - First type","Third type - First type","Third type - Second type"};
+
+    //Run by the worker that finished each tile, before it is pushed to completedTiles_*
+    auto finishTile_first_float=[&](TileResult tile) {
+        PaintTile(framebuffer_first_float,pointsToCalc_first_float,tileGrid,tile.tile,iterationColors);
+        differences.UpdateTile(1,pointsToCalc_first_float.iterations.data(),tile.tile);
+    };
+    auto finishTile_second_float=[&](TileResult tile) {
+        PaintTile(framebuffer_second_float,pointsToCalc_second_float,tileGrid,tile.tile,iterationColors);
+        differences.UpdateTile(2,pointsToCalc_second_float.iterations.data(),tile.tile);
+    };
+    auto finishTile_third_float=[&](TileResult tile) {
+        PaintTile(framebuffer_third_float,pointsToCalc_third_float,tileGrid,tile.tile,iterationColors);
+        differences.UpdateTile(3,pointsToCalc_third_float.iterations.data(),tile.tile);
+    };
+
+    // OPTION: How the workers are shared among the three types.  Balanced gives every free core to the type with the most estimated work left, so all three
+    // finish at about the same time.  DisplayedFirst finishes the types on screen first.  Toggle at runtime with H.  See msetScheduler.hpp.
+    BatchScheduler scheduler;
+    scheduler.SetPolicy(SchedulePolicy::Balanced);
+
+    //Spin up the worker threads.  They stay alive for the whole run and pull batches of all three types from the pool.
+    ThreadPool pool(numThreads);
+    bool poolPaused=false;
+
+    //Incremented whenever the view or max iterations change, which cancels every batch queued for the previous generation (see CancelToken)
+    std::atomic<unsigned int> calcGeneration(0);
+    cout<<"Started "<<pool.Size()<<" worker threads"<<endl;
+
+    //Ranges of points each type has to compute at the next submitAllBatches.  The whole image, except straight after a pan (see doPan below).
+    vector<IndexRange> calcRanges_first_float={{0,pointsToCalc_first_float.Size()}};
+    vector<IndexRange> calcRanges_second_float={{0,pointsToCalc_second_float.Size()}};
+    vector<IndexRange> calcRanges_third_float={{0,pointsToCalc_third_float.Size()}};
+
+    //Queues the tiles of all three types with the scheduler, which decides which type each free worker takes on next, nearest the focus first (see tileGrid).
+    //Each tile comes back through completedTiles_* because tiles do not necessarily finish in the order they were queued.
+    //Types rendered by perturbation are queued as a single task that computes the reference orbit and then queues that type's tiles itself.
+    //Types rendered by Mariani-Silver are queued as one task per rectangle of new pixels (the whole image unless panned or zoomed), which splits it into
+    //rectangle tasks as it goes.
+    //Types rendered progressively are queued one level at a time, each level's last batch queueing the next.
+    //Only calcRanges_* are queued, which then go back to the whole image, except that Mariani-Silver renders the whole image when they are too scattered
+    //to split into a few rectangles (see MarianiSilverRects).  Progressive rendering is only used for the whole image.
+    auto submitAllBatches=[&]() {
+        MSET_TRACE_SCOPE("submit batches");
+        //Catches the difference maps up with whatever the workers did not report before they were stopped, and with points moved by a pan or zoom
+        differences.UpdateAll(pointsToCalc_first_float.iterations.data(),pointsToCalc_second_float.iterations.data(),pointsToCalc_third_float.iterations.data(),
+                              poolPaused?nullptr:&pool);
+        int maxIter=maxIterations;
+        unsigned int zdp=zoomDenomPower;
+        CancelToken cancel={&calcGeneration,calcGeneration.load()};
+        int_vector2 focus=(tilesFromMouse && mouseIsInBounds(mousePos))?int_vector2{(int)mousePos.x,(int)mousePos.y}:int_vector2{512,512};
+        //Each type's kernel with this generation's max iterations and CancelToken.  calc_* also record each call as a batch of that type when tracing
+        //(see msetTrace.hpp); the scheduler records its own batches.
+        auto kernel_first_float=[maxIter,cancel](PointStore_first_float &points, IndexRange range) { return msetBatchSimd(points,range,maxIter,cancel); };
+        auto kernel_second_float=[maxIter,cancel](PointStore_second_float &points, IndexRange range) { return msetBatchSimd(points,range,maxIter,cancel); };
+        auto kernel_third_float=[maxIter,cancel](PointStore_third_float &points, IndexRange range) { return msetBatchSimd(points,range,maxIter,cancel); };
+        auto calc_first_float=[kernel_first_float](PointStore_first_float &points, IndexRange range) {
+            return TraceBatch(1,points,range,[&]() { return kernel_first_float(points,range); }); };
+        auto calc_second_float=[kernel_second_float](PointStore_second_float &points, IndexRange range) {
+            return TraceBatch(2,points,range,[&]() { return kernel_second_float(points,range); }); };
+        auto calc_third_float=[kernel_third_float](PointStore_third_float &points, IndexRange range) {
+            return TraceBatch(3,points,range,[&]() { return kernel_third_float(points,range); }); };
+        bool scheduled_first_float=false, scheduled_second_float=false, scheduled_third_float=false;
+
+        marianiSilverRunning_first_float=useMarianiSilver_first_float;
+        marianiSilverRunning_second_float=useMarianiSilver_second_float && !usePerturbation_second_float;
+        marianiSilverRunning_third_float=useMarianiSilver_third_float && !usePerturbation_third_float;
+        progressiveRunning_first_float=useProgressive && !marianiSilverRunning_first_float && (calcRanges_first_float.size()==1) && (calcRanges_first_float[0].Size()==pointsToCalc_first_float.Size());
+        progressiveRunning_second_float=useProgressive && !marianiSilverRunning_second_float && (calcRanges_second_float.size()==1) && (calcRanges_second_float[0].Size()==pointsToCalc_second_float.Size());
+        progressiveRunning_third_float=useProgressive && !marianiSilverRunning_third_float && (calcRanges_third_float.size()==1) && (calcRanges_third_float[0].Size()==pointsToCalc_third_float.Size());
+        if (marianiSilverRunning_first_float) {
+            msStats_first_float.Reset();
+            StartMarianiSilver<PointStore_first_float>(pointsToCalc_first_float,1024,calcRanges_first_float,calc_first_float,cancel,pool,completedRanges_first_float,msStats_first_float,verifyMarianiSilver);
+        }
+        else if (progressiveRunning_first_float) {
+            progressiveStats_first_float.Reset();
+            StartProgressive<PointStore_first_float>(pointsToCalc_first_float,1024,calc_first_float,cancel,pool,completedRanges_first_float,progressiveStats_first_float,scheduler.BatchSize(1,batchSize_first_float));
+        }
+        else scheduled_first_float=true;
+        if (marianiSilverRunning_second_float) {
+            msStats_second_float.Reset();
+            StartMarianiSilver<PointStore_second_float>(pointsToCalc_second_float,1024,calcRanges_second_float,calc_second_float,cancel,pool,completedRanges_second_float,msStats_second_float,verifyMarianiSilver);
+        }
+        else if (progressiveRunning_second_float && !usePerturbation_second_float) {
+            progressiveStats_second_float.Reset();
+            StartProgressive<PointStore_second_float>(pointsToCalc_second_float,1024,calc_second_float,cancel,pool,completedRanges_second_float,progressiveStats_second_float,scheduler.BatchSize(2,batchSize_second_float));
+        }
+        else if (!usePerturbation_second_float) scheduled_second_float=true;
+        if (marianiSilverRunning_third_float) {
+            msStats_third_float.Reset();
+            StartMarianiSilver<PointStore_third_float>(pointsToCalc_third_float,1024,calcRanges_third_float,calc_third_float,cancel,pool,completedRanges_third_float,msStats_third_float,verifyMarianiSilver);
+        }
+        else if (progressiveRunning_third_float && !usePerturbation_third_float) {
+            progressiveStats_third_float.Reset();
+            StartProgressive<PointStore_third_float>(pointsToCalc_third_float,1024,calc_third_float,cancel,pool,completedRanges_third_float,progressiveStats_third_float,scheduler.BatchSize(3,batchSize_third_float));
+        }
+        else if (!usePerturbation_third_float) scheduled_third_float=true;
+
+        if (usePerturbation_second_float) {
+            vector<IndexRange> ranges;
+            if (progressiveRunning_second_float) {
+                progressiveStats_second_float.Reset();
+                progressiveStats_second_float.tasksPending++;  //Held by the reference orbit task, so the type does not look finished before its levels are queued
+            }
+            else {
+                ranges=calcRanges_second_float;
+                scheduler.Hold(2);  //Released by the reference orbit task once it has queued the tiles
+            }
+            perturbStats_second_float.Reset();
+            MyComplex_second_float center=coordCenter_second_float;
+            bool progressive=progressiveRunning_second_float;
+            pool.Submit([=,&pool,&scheduler,&pointsToCalc_second_float,&completedTiles_second_float,&completedRanges_second_float,&perturbStats_second_float,&progressiveStats_second_float]() {
+                MSET_TRACE_SCOPE("reference orbit");
+                auto frame=std::make_shared<PerturbationFrame>();
+                bool computed=frame->Compute(center,maxIter,zdp,512,seriesOrder,cancel);
+                if (computed) {
+                    perturbStats_second_float.referenceLength=frame->ref.Length();
+                    perturbStats_second_float.seriesSkip=frame->SeriesSkip();
+                }
+                auto kernel=[frame,maxIter,cancel,&perturbStats_second_float](PointStore_second_float &points, IndexRange range) {
+                    return frame->Batch(points,range,maxIter,cancel,&perturbStats_second_float); };
+                auto calc=[kernel](PointStore_second_float &points, IndexRange range) { return TraceBatch(2,points,range,[&]() { return kernel(points,range); }); };
+                if (progressive) {
+                    if (computed) StartProgressive<PointStore_second_float>(pointsToCalc_second_float,1024,calc,cancel,pool,completedRanges_second_float,progressiveStats_second_float,scheduler.BatchSize(2,batchSize_first_float));
+                    progressiveStats_second_float.tasksPending--;
+                    return;
+                }
+                if (computed) scheduler.AddTiles(pool,2,pointsToCalc_second_float,tileGrid,ranges,focus,kernel,finishTile_second_float,cancel,completedTiles_second_float,batchSize_first_float);  //Deltas are double, so batches start first_float sized
+                scheduler.Release(2);
+            });
+        }
+        if (usePerturbation_third_float) {
+            vector<IndexRange> ranges;
+            if (progressiveRunning_third_float) {
+                progressiveStats_third_float.Reset();
+                progressiveStats_third_float.tasksPending++;  //Held by the reference orbit task, so the type does not look finished before its levels are queued
+            }
+            else {
+                ranges=calcRanges_third_float;
+                scheduler.Hold(3);  //Released by the reference orbit task once it has queued the tiles
+            }
+            perturbStats_third_float.Reset();
+            MyComplex_third_float center=coordCenter_third_float;
+            bool progressive=progressiveRunning_third_float;
+            pool.Submit([=,&pool,&scheduler,&pointsToCalc_third_float,&completedTiles_third_float,&completedRanges_third_float,&perturbStats_third_float,&progressiveStats_third_float]() {
+                MSET_TRACE_SCOPE("reference orbit");
+                auto frame=std::make_shared<PerturbationFrame>();
+                bool computed=frame->Compute(center,maxIter,zdp,512,seriesOrder,cancel);
+                if (computed) {
+                    perturbStats_third_float.referenceLength=frame->ref.Length();
+                    perturbStats_third_float.seriesSkip=frame->SeriesSkip();
+                }
+                auto kernel=[frame,maxIter,cancel,&perturbStats_third_float](PointStore_third_float &points, IndexRange range) {
+                    return frame->Batch(points,range,maxIter,cancel,&perturbStats_third_float); };
+                auto calc=[kernel](PointStore_third_float &points, IndexRange range) { return TraceBatch(3,points,range,[&]() { return kernel(points,range); }); };
+                if (progressive) {
+                    if (computed) StartProgressive<PointStore_third_float>(pointsToCalc_third_float,1024,calc,cancel,pool,completedRanges_third_float,progressiveStats_third_float,scheduler.BatchSize(3,batchSize_first_float));
+                    progressiveStats_third_float.tasksPending--;
+                    return;
+                }
+                if (computed) scheduler.AddTiles(pool,3,pointsToCalc_third_float,tileGrid,ranges,focus,kernel,finishTile_third_float,cancel,completedTiles_third_float,batchSize_first_float);
+                scheduler.Release(3);
+            });
+        }
+
+        if (scheduled_first_float) scheduler.AddTiles(pool,1,pointsToCalc_first_float,tileGrid,calcRanges_first_float,focus,kernel_first_float,finishTile_first_float,cancel,completedTiles_first_float,batchSize_first_float);
+        if (scheduled_second_float) scheduler.AddTiles(pool,2,pointsToCalc_second_float,tileGrid,calcRanges_second_float,focus,kernel_second_float,finishTile_second_float,cancel,completedTiles_second_float,batchSize_second_float);
+        if (scheduled_third_float) scheduler.AddTiles(pool,3,pointsToCalc_third_float,tileGrid,calcRanges_third_float,focus,kernel_third_float,finishTile_third_float,cancel,completedTiles_third_float,batchSize_third_float);
+
+        calcRanges_first_float={{0,pointsToCalc_first_float.Size()}};
+        calcRanges_second_float={{0,pointsToCalc_second_float.Size()}};
+        calcRanges_third_float={{0,pointsToCalc_third_float.Size()}};
+    };
+
+    //Cancels running batches, drops queued ones and waits the few milliseconds it takes the workers to notice, so the point lists can be safely reset.
+    //Nothing computed for the old view can be written after this returns.  A paused pool is let run meanwhile: a task that was running may still queue another
+    //(a Mariani-Silver rectangle, or tiles once a reference orbit is done) just as it is cancelled, and that one returns at once but must be taken to be waited for.
+    auto stopAllBatches=[&]() {
+        calcGeneration++;
+        pool.ClearPending();
+        if (poolPaused) pool.SetPaused(false);
+        pool.WaitIdle();
+        if (poolPaused) pool.SetPaused(true);
+        scheduler.Clear();
+        completedTiles_first_float.Clear();
+        completedTiles_second_float.Clear();
+        completedTiles_third_float.Clear();
+        tilesToDraw_first_float.clear();
+        tilesToDraw_second_float.clear();
+        tilesToDraw_third_float.clear();
+        completedRanges_first_float.Clear();
+        completedRanges_second_float.Clear();
+        completedRanges_third_float.Clear();
+        rangesToDraw_first_float.clear();
+        rangesToDraw_second_float.clear();
+        rangesToDraw_third_float.clear();
+        workPending_first_float=0;
+        workPending_second_float=0;
+        workPending_third_float=0;
+        PeriodicPoints<first_float>()=0;
+        PeriodicPoints<second_float>()=0;
+        PeriodicPoints<third_float>()=0;
+        InteriorTestPoints<first_float>()=0;
+        InteriorTestPoints<second_float>()=0;
+        InteriorTestPoints<third_float>()=0;
+        drawIter_first_float={0,0};
+        drawIter_second_float={0,0};
+        drawIter_third_float={0,0};
+    };
+
+    //Pre-draw Mandelbrot set on (-2,2) to (2,2) on msetCanvas to make a background for pathDrawings.
+    //The addition of this code makes the first pass on the first float type redundant
+    //Only used on display screen mode 7.  For screen mode 8, it's easier to find interesting points with the zoomed-in image as background.
+    //TODO: Perhaps omit this and screen mode 7 entirely?
+    //Iterates a scratch copy of the first type's points, in bands spread over the workers, before the real ones are queued
+    Framebuffer<Color> canvasFramebuffer(tileGrid,BLACK);
+    {
+        PointStore_first_float canvasPoints(1024);
+        canvasPoints.SetView(coordCenter_first_float,zoomDenomPower);
+        canvasPoints.InvalidateCoords();
+        size_t band=canvasPoints.Size()/(4*pool.Size())+1;
+        for (size_t start=0;start<canvasPoints.Size();start+=band) {
+            IndexRange range={start,std::min(start+band,canvasPoints.Size())};
+            pool.Submit([&,range]() {
+                msetBatchSimd(canvasPoints,range,maxIterations);
+                PaintRange(canvasFramebuffer,canvasPoints,range,iterationColors);
+            });
+        }
+        pool.WaitIdle();
+    }
+
+    //Initialize RayLib display and textures.  Each screen's texture starts as a copy of its framebuffer, which is why the first batches are only queued
+    //once they are loaded.  The path drawings are drawn by RayLib.
+    const int screenWidth = 1200;
+    const int screenHeight = 1024;
+    InitWindow(screenWidth, screenHeight, "");
+    SetTargetFPS(30);
+    auto loadFramebufferTexture=[](Framebuffer<Color> &image) {
+        return LoadTextureFromImage((Image){image.Data(),image.Width(),image.Height(),1,PIXELFORMAT_UNCOMPRESSED_R8G8B8A8});
+    };
+    Texture2D msetTexture_first_float=loadFramebufferTexture(framebuffer_first_float);
+    Texture2D msetTexture_second_float=loadFramebufferTexture(framebuffer_second_float);
+    Texture2D msetTexture_third_float=loadFramebufferTexture(framebuffer_third_float);
+    Texture2D diffScreen2M1=loadFramebufferTexture(differences.Image(0));
+    Texture2D diffScreen3M1=loadFramebufferTexture(differences.Image(1));
+    Texture2D diffScreen3M2=loadFramebufferTexture(differences.Image(2));
+    Texture2D msetCanvas=loadFramebufferTexture(canvasFramebuffer);
+    RenderTexture2D pathDrawings=LoadRenderTexture(1024,1024);
+
+    //Uploads the regions of a framebuffer marked since the last upload to its texture
+    auto uploadFramebuffer=[](Framebuffer<Color> &image, Texture2D texture) {
+        image.Flush([&](const Color *data, int x, int y, int width, int height) {
+            UpdateTextureRec(texture,(Rectangle){(float)x,(float)y,(float)width,(float)height},data);
+        });
+    };
+
+    submitAllBatches();
+
+    //Initialize vectors which hold paths to plot for screen modes 7 and 8 where the trajectory of a point is plotted
+    vector<int_vector2> pathPoints_first_float;
+    vector<int_vector2> pathPoints_second_float;
+    vector<int_vector2> pathPoints_third_float;
+    MyComplex_first_float firstPathPoint_first_float;
+    MyComplex_second_float firstPathPoint_second_float;
+    MyComplex_third_float firstPathPoint_third_float;
+
+    //For drawing textures to screen.  Textures loaded from framebuffers are the right way up (imageRec).  RenderTextures are not: flipRec has a final value
+    //that is negative to flip the Y axis from screen coordinates (+Y is down) to Cartesian (+Y is up)
+    Rectangle imageRec=(Rectangle){0.0f,0.0f,1024.0f,1024.0f};
+    Rectangle flipRec=(Rectangle){0.0f,0.0f,1024.0f,-1024.0f};  //Flips Y-axis
+    Vector2 origin=(Vector2){0.0f,0.0f};
+
+    //Uploads the tiles of a difference map that changed since the last upload
+    auto uploadDifferences=[&](int pair, Texture2D texture) {
+        differences.Flush(pair,[&](const Color *data, int x, int y, int width, int height) {
+            UpdateTextureRec(texture,(Rectangle){(float)x,(float)y,(float)width,(float)height},data);
+        });
+    };
+
+    //Colors a range of a type that the UI thread was handed by Mariani-Silver or progressive rendering, and marks its rows for upload.  Progressive
+    //rendering draws each pixel as a block reaching to the next sample (see ProgressiveBlockSize), which finer levels paint over.
+    auto paintFinishedRange=[&](Framebuffer<Color> &image, const auto &points, IndexRange range, bool progressive) {
+        if (range.Size()==0) return;
+        if (!progressive) {
+            PaintRange(image,points,range,iterationColors);
+            image.MarkRows(points.GridPos(range.start).y,points.GridPos(range.end-1).y+1);
+            return;
+        }
+        for (size_t p=range.start;p<range.end;p++) {
+            int_vector2 gp=points.GridPos(p);
+            int blockSize=ProgressiveBlockSize(gp);
+            image.FillRect(gp.x,gp.y,blockSize,blockSize,iterationColors(points.iterations[p]));
+            image.MarkRows(gp.y,gp.y+blockSize);
+        }
+    };
+
+    //Blanks a type's image for a new view.  Only while the workers are stopped.
+    auto eraseFramebuffer=[&](Framebuffer<Color> &image, Texture2D texture) {
+        image.Fill(BLACK);
+        image.MarkAll();
+        uploadFramebuffer(image,texture);
+    };
+
+    //Moves a type's image by panShift pixels, after ShiftPoints, and uploads it whole.  Uncovered pixels are black.  Only while the workers are stopped.
+    auto shiftFramebuffer=[&](Framebuffer<Color> &image, Texture2D texture) {
+        image.Shift(panShift.x,panShift.y,BLACK);
+        image.MarkAll();
+        uploadFramebuffer(image,texture);
+    };
+
+    //After ZoomPoints: zooming in, the middle of the old image is magnified as a preview of the new one; zooming out, the rest is black.  Points carried over
+    //are then colored exactly and the image is uploaded whole.  Only while the workers are stopped.
+    auto zoomFramebuffer=[&](Framebuffer<Color> &image, Texture2D texture, int step, auto &points, const auto &ranges) {
+        image.Magnify(step,BLACK);
+        PaintPointsOutside(image,points,ranges,iterationColors);
+        image.MarkAll();
+        uploadFramebuffer(image,texture);
+    };
+
+#if MSET_TRACE
+    //Iterations per second of each type, from the traced batches' iteration counts over the last half second or so
+    double iterationRateTime=GetTime();
+    unsigned long long iterationRateCount[3]={TraceIterations(1),TraceIterations(2),TraceIterations(3)};
+    double iterationsPerSecond[3]={0.0,0.0,0.0};
+#endif
+
+// Begin main loop
+while (!WindowShouldClose())    // Detect window close button or ESC key
+{
+    // Detect user input
+    mousePos=GetMousePosition();
+    if (mouseIsInBounds(mousePos)) {
+        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON) ) {
+                oldCoordCenter_first_float=coordCenter_first_float;
+                oldCoordCenter_second_float=coordCenter_second_float;
+                oldCoordCenter_third_float=coordCenter_third_float;
+                coordCenter_first_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_first_float,zoomDenomPower);
+                coordCenter_second_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_second_float,zoomDenomPower);
+                coordCenter_third_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_third_float,zoomDenomPower);
+                cout<<"Mouse x:"<<mousePos.x<<" y:"<<mousePos.y<<" New center coord x:"<<coordCenter_first_float.real<<" y:"<<coordCenter_first_float.imag<<endl;
+                panShift={panShift.x+(int)mousePos.x-512,panShift.y+(int)mousePos.y-512};
+                doPan=true;
+            }
+        if (IsKeyPressed(KEY_SLASH)) {
+            MyComplex_first_float queriedPoint=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_first_float,zoomDenomPower);
+            //cout<<setprecision(33);
+            cout<<"Location as type 1: "<<queriedPoint<<endl;
+            cout<<"Recast as type 2: "<<MyComplex_second_float(queriedPoint)<<endl;
+            cout<<"Recast as type 3: "<<MyComplex_third_float(queriedPoint)<<endl;
+            //cout<<setprecision(16);
+        }
+        if (IsKeyDown(KEY_SEVEN)) {
+                printDifference=true; pauseCalc=true; displayScreen=7; drawThreePaths=true;
+                firstPathPoint_first_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_first_float,zoomDenomPower);
+                firstPathPoint_second_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_second_float,zoomDenomPower);
+                firstPathPoint_third_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_third_float,zoomDenomPower);
+        }
+        if (IsKeyDown(KEY_EIGHT)) {
+                pauseCalc=true; displayScreen=8; drawThreePaths=true;
+                firstPathPoint_first_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_first_float,zoomDenomPower);
+                firstPathPoint_second_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_second_float,zoomDenomPower);
+                firstPathPoint_third_float=Grid2Coord({(int)mousePos.x,(int)mousePos.y},coordCenter_third_float,zoomDenomPower);
+        }
+    }
+
+    if (IsKeyDown(KEY_PERIOD)) { zoomDenomPower++; doZoom=true; cout<<"Increasing denom power to "<<zoomDenomPower<<" = 1/"<<ldexp(floatexp(1.0),zoomDenomPower)<<endl;}
+    if (IsKeyDown(KEY_SEMICOLON)) { zoomDenomPower+=3; doZoom=true; cout<<"Increasing denom power to "<<zoomDenomPower<<" = 1/"<<ldexp(floatexp(1.0),zoomDenomPower)<<endl;}
+    if (IsKeyDown(KEY_COMMA)) { zoomDenomPower--; doZoom=true; if (zoomDenomPower<6) zoomDenomPower=6; cout<<"Decreasing denom power to "<<zoomDenomPower<<" = 1/"<<ldexp(floatexp(1.0),zoomDenomPower)<<endl;}
+    if (IsKeyDown(KEY_M)) {maxIterations++; recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl;}
+    if (IsKeyDown(KEY_N)) {maxIterations--; if (maxIterations<2) maxIterations=2; recalcSamePoints=true; cout<<"Decreasing Max Iter to "<<maxIterations<<endl;}
+    if (IsKeyDown(KEY_K)) {maxIterations+=10; recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl;}
+    if (IsKeyDown(KEY_J)) {maxIterations-=10; if (maxIterations<2) maxIterations=2; recalcSamePoints=true; cout<<"Decreasing Max Iter to "<<maxIterations<<endl;}
+    if (IsKeyDown(KEY_O)) {
+        if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
+            maxIterations=((maxIterations/1000)+1)*1000; recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl; //Increase to next even thousand
+        }
+        else {
+            maxIterations+=100; recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl;
+        }
+    }
+    if (IsKeyDown(KEY_I)) {
+        if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
+            maxIterations=((maxIterations/1000)-1)*1000; if (maxIterations<2) maxIterations=2;
+            recalcSamePoints=true; cout<<"Increasing Max Iter to "<<maxIterations<<endl; //Increase to next even thousand
+        }
+        else {
+            maxIterations-=100; if (maxIterations<2) maxIterations=2; recalcSamePoints=true; cout<<"Decreasing Max Iter to "<<maxIterations<<endl;
+        }
+    }
+    if (IsKeyPressed(KEY_P)) pauseCalc=!pauseCalc;
+    if (IsKeyPressed(KEY_H)) {
+        scheduler.SetPolicy((scheduler.Policy()==SchedulePolicy::Balanced)?SchedulePolicy::DisplayedFirst:SchedulePolicy::Balanced);
+        cout<<"Scheduling "<<((scheduler.Policy()==SchedulePolicy::Balanced)?"balanced across types":"displayed screen first")<<endl;
+    }
+#if MSET_TRACE
+    if (IsKeyPressed(KEY_T)) cout<<(TraceDump("mset_trace.json")?"Wrote":"Could not write")<<" trace to mset_trace.json"<<endl;
+#endif
+    if (IsKeyPressed(KEY_C)) highlightCenterOfScreen=!highlightCenterOfScreen;
+    if (IsKeyPressed(KEY_G)) showGrid=!showGrid;
+    if (IsKeyPressed(KEY_Y)) {
+        PeriodicityCheckEnabled()=!PeriodicityCheckEnabled();
+        recalcSamePoints=true;
+        resetOrbits=true;  //Points it proved interior must be iterated again
+        cout<<"Periodicity checking "<<(PeriodicityCheckEnabled()?"on":"off")<<endl;
+    }
+    if (IsKeyPressed(KEY_X)) {
+        usePerturbation_third_float=!usePerturbation_third_float;
+        usePerturbation_second_float=usePerturbation_third_float;
+        scheduler.ResetEstimates(2);
+        scheduler.ResetEstimates(3);
+        recalcSamePoints=true;
+        cout<<"Perturbation for second and third types "<<(usePerturbation_third_float?"on":"off")<<endl;
+    }
+    if (IsKeyPressed(KEY_F)) {
+        useProgressive=!useProgressive;
+        recalcSamePoints=true;
+        resetOrbits=true;  //Otherwise the resumed points would all be finished before the coarse levels could show anything
+        cout<<"Progressive rendering "<<(useProgressive?"on":"off")<<endl;
+    }
+    if (IsKeyPressed(KEY_B) && (displayScreen>=1) && (displayScreen<=3)) {
+        bool &useMarianiSilver=(displayScreen==1)?useMarianiSilver_first_float:((displayScreen==2)?useMarianiSilver_second_float:useMarianiSilver_third_float);
+        useMarianiSilver=!useMarianiSilver;
+        recalcSamePoints=true;
+        cout<<"Mariani-Silver for type "<<displayScreen<<" "<<(useMarianiSilver?"on":"off")<<endl;
+    }
+    if (IsKeyDown(KEY_R)) {
+        cout<<"Reverting to previous center of x:"<<oldCoordCenter_first_float.real<<" y:"<<oldCoordCenter_first_float.imag<<endl;
+        coordCenter_first_float=oldCoordCenter_first_float;
+        coordCenter_second_float=oldCoordCenter_second_float;
+        coordCenter_third_float=oldCoordCenter_third_float;
+        doNewCalc=true;
+    }
+    if (IsKeyDown(KEY_ONE)) displayScreen=1;
+    if (IsKeyDown(KEY_TWO)) displayScreen=2;
+    if (IsKeyDown(KEY_THREE)) displayScreen=3;
+    if (IsKeyDown(KEY_FOUR)) { printDifference=true; displayScreen=4; } // Second - first
+    if (IsKeyDown(KEY_FIVE)) { printDifference=true; displayScreen=5; } // Third - first
+    if (IsKeyDown(KEY_SIX)) { printDifference=true; displayScreen=6; }  // Third - second
+    if (IsKeyDown(KEY_U)) { pauseCalc=false; displayScreen=1; }  //Unpause
+    if (IsKeyDown(KEY_D)) { //Reprint type data
+        cout<<"Limits of types:"<<endl;
+        cout<<"1st float type:\n\tRadix digits: "<<std::numeric_limits<first_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<first_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<first_float>::epsilon()<<"\tmin: "<<std::numeric_limits<first_float>::min()<<"\tMin exponent: "<<std::numeric_limits<first_float>::min_exponent<<"\n\n";
+        cout<<"2nd float type:\n\tRadix digits: "<<std::numeric_limits<second_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<second_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<second_float>::epsilon()<<"\tmin: "<<std::numeric_limits<second_float>::min()<<"\tMin exponent: "<<std::numeric_limits<second_float>::min_exponent<<"\n\n";
+        cout<<"3rd float type:\n\tRadix digits: "<<std::numeric_limits<third_float>::digits<<"\tBase 10 digits: "<<std::numeric_limits<third_float>::digits10<<"\n\tepsilon: "<<std::numeric_limits<third_float>::epsilon()<<"\tmin: "<<std::numeric_limits<third_float>::min()<<"\tMin exponent: "<<std::numeric_limits<third_float>::min_exponent<<"\n\n";
+        cout<<"Iteration difference type: Base 10 digits: "<<std::numeric_limits<int>::digits10<<" Max: "<<(int)std::numeric_limits<int>::max()<<endl;
+    }
+
+    //Recentering by a whole number of pixels keeps everything still on screen: the point lists and images are shifted, coords are rebuilt from the new
+    //center, and only the newly exposed strips are queued.  A type whose previous render had not finished is queued whole, which resumes its unfinished points.
+    if (doPan && doZoom) doNewCalc=true;
+    if (doPan && !doNewCalc && (abs(panShift.x)<1024) && (abs(panShift.y)<1024)) {
+        MSET_TRACE_SCOPE("pan");
+        bool unfinished_first_float=(workPending_first_float>0);
+        bool unfinished_second_float=(workPending_second_float>0);
+        bool unfinished_third_float=(workPending_third_float>0);
+        stopAllBatches();
+        shiftFramebuffer(framebuffer_first_float,msetTexture_first_float);
+        shiftFramebuffer(framebuffer_second_float,msetTexture_second_float);
+        shiftFramebuffer(framebuffer_third_float,msetTexture_third_float);
+
+        setPointViews();
+        calcRanges_first_float=ShiftPoints(pointsToCalc_first_float,1024,panShift.x,panShift.y);
+        calcRanges_second_float=ShiftPoints(pointsToCalc_second_float,1024,panShift.x,panShift.y);
+        calcRanges_third_float=ShiftPoints(pointsToCalc_third_float,1024,panShift.x,panShift.y);
+        if (unfinished_first_float) calcRanges_first_float={{0,pointsToCalc_first_float.Size()}};
+        if (unfinished_second_float) calcRanges_second_float={{0,pointsToCalc_second_float.Size()}};
+        if (unfinished_third_float) calcRanges_third_float={{0,pointsToCalc_third_float.Size()}};
+
+        numPointsToCalc=0;
+        for (const IndexRange &r:calcRanges_first_float) numPointsToCalc+=(unsigned int)r.Size();
+        for (const IndexRange &r:calcRanges_second_float) numPointsToCalc+=(unsigned int)r.Size();
+        for (const IndexRange &r:calcRanges_third_float) numPointsToCalc+=(unsigned int)r.Size();
+        cout<<"Panned by "<<panShift.x<<","<<panShift.y<<" pixels, "<<numPointsToCalc<<" points to compute"<<endl;
+        numPointsFinished=0;
+        numPointsUpdated=0;
+        submitAllBatches();
+    }
+    else if (doPan) doNewCalc=true;
+    doPan=false;
+    panShift={0,0};
+
+    //Zooming by a power of two about the center keeps the points that land exactly on old ones, and only queues the rest: 3/4 of the image zooming in by
+    //two, 63/64 by eight, and 3/4 zooming out by two.  Otherwise as for panning.
+    int zoomStep=(int)zoomDenomPower-(int)pointsZoomDenomPower;
+    if (doZoom && !doNewCalc && (zoomStep!=0) && (abs(zoomStep)<10)) {
+        MSET_TRACE_SCOPE("zoom");
+        bool unfinished_first_float=(workPending_first_float>0);
+        bool unfinished_second_float=(workPending_second_float>0);
+        bool unfinished_third_float=(workPending_third_float>0);
+        stopAllBatches();
+        SetPeriodicityTolerance(zoomDenomPower);
+
+        setPointViews();
+        calcRanges_first_float=ZoomPoints(pointsToCalc_first_float,1024,zoomStep);
+        calcRanges_second_float=ZoomPoints(pointsToCalc_second_float,1024,zoomStep);
+        calcRanges_third_float=ZoomPoints(pointsToCalc_third_float,1024,zoomStep);
+        zoomFramebuffer(framebuffer_first_float,msetTexture_first_float,zoomStep,pointsToCalc_first_float,calcRanges_first_float);
+        zoomFramebuffer(framebuffer_second_float,msetTexture_second_float,zoomStep,pointsToCalc_second_float,calcRanges_second_float);
+        zoomFramebuffer(framebuffer_third_float,msetTexture_third_float,zoomStep,pointsToCalc_third_float,calcRanges_third_float);
+        if (unfinished_first_float) calcRanges_first_float={{0,pointsToCalc_first_float.Size()}};
+        if (unfinished_second_float) calcRanges_second_float={{0,pointsToCalc_second_float.Size()}};
+        if (unfinished_third_float) calcRanges_third_float={{0,pointsToCalc_third_float.Size()}};
+        pointsZoomDenomPower=zoomDenomPower;
+
+        numPointsToCalc=0;
+        for (const IndexRange &r:calcRanges_first_float) numPointsToCalc+=(unsigned int)r.Size();
+        for (const IndexRange &r:calcRanges_second_float) numPointsToCalc+=(unsigned int)r.Size();
+        for (const IndexRange &r:calcRanges_third_float) numPointsToCalc+=(unsigned int)r.Size();
+        cout<<"Zoomed by 2^"<<zoomStep<<", "<<numPointsToCalc<<" points to compute"<<endl;
+        numPointsFinished=0;
+        numPointsUpdated=0;
+        submitAllBatches();
+    }
+    else if (doZoom && (zoomStep!=0)) doNewCalc=true;
+    doZoom=false;
+
+    //If we have changed the center point or zoomed in, every point of all three types needs a new coordinate.  Only the view changes here; the workers
+    //generate the coordinates of the points in each batch as they start it, so computing starts straight away.  We also reset all pointers and stats.
+    if (doNewCalc) {
+        MSET_TRACE_SCOPE("new view");
+        cout<<"Waiting for old threads to finish..."<<std::flush;
+        stopAllBatches();
+        cout<<"Threads terminated."<<endl;
+        cout<<"Resetting points to plot... "<<std::flush;
+        eraseFramebuffer(framebuffer_first_float,msetTexture_first_float);
+        eraseFramebuffer(framebuffer_second_float,msetTexture_second_float);
+        eraseFramebuffer(framebuffer_third_float,msetTexture_third_float);
+        SetPeriodicityTolerance(zoomDenomPower);
+        pointsZoomDenomPower=zoomDenomPower;
+        setPointViews();
+        pointsToCalc_first_float.InvalidateCoords();
+        pointsToCalc_second_float.InvalidateCoords();
+        pointsToCalc_third_float.InvalidateCoords();
+        doNewCalc=false;
+        cout<<"done."<<endl;
+        numPointsToCalc=pointsToCalc_first_float.Size()+pointsToCalc_second_float.Size()+pointsToCalc_third_float.Size();
+        numPointsFinished=0;
+        numPointsUpdated=0;
+        submitAllBatches();
+    } //End-if doNewCalc
+
+    //When we simply increase or decrease iterations, just overwrite the iteration values of the existing points without recomputing the complex plane coordinates associated with each pixel, since these have not changed
+    //Resets our pointers and stats but saves generating C again for 3x1024x1024 pixels.  Each point's orbit carries on from where it stopped
+    //(see PointStore), so raising max iterations only costs the extra iterations of points that had not escaped, and lowering it costs no iterations at all.
+    if (recalcSamePoints) {
+        MSET_TRACE_SCOPE("recalculate");
+        cout<<"Waiting for old threads to finish..."<<std::flush;
+        stopAllBatches();
+        cout<<"Threads terminated."<<endl;
+        if (resetOrbits) {
+            pointsToCalc_first_float.ResetOrbits();
+            pointsToCalc_second_float.ResetOrbits();
+            pointsToCalc_third_float.ResetOrbits();
+            resetOrbits=false;
+        }
+        cout<<"Points to plot have been reset."<<std::endl;
+
+        recalcSamePoints=false;
+        numPointsToCalc=pointsToCalc_first_float.Size()+pointsToCalc_second_float.Size()+pointsToCalc_third_float.Size();
+        numPointsFinished=0;
+        numPointsUpdated=0;
+        submitAllBatches();
+    } //End-if recalcSamePoints
+
+    //Plots trajectories for a single point using three different float types.  For display screen modes 7 and 8.
+    if (drawThreePaths) {
+        pathPoints_first_float.clear();
+        pathPoints_second_float.clear();
+        pathPoints_third_float.clear();
+        pathPoints_first_float=msetPath(firstPathPoint_first_float, maxIterations);
+        pathPoints_second_float=msetPath(firstPathPoint_second_float, maxIterations);
+        pathPoints_third_float=msetPath(firstPathPoint_third_float, maxIterations);
+
+        cout<<"Coordinates:\nFirst float:"<<firstPathPoint_first_float<<endl;
+        cout<<"Second float:"<<firstPathPoint_second_float<<endl;
+        cout<<"Third float:"<<firstPathPoint_third_float<<endl;
+        cout<<"Iterations: 1st: "<<pathPoints_first_float.size()<<" 2nd: "<<pathPoints_second_float.size()<<" 3rd: "<<pathPoints_third_float.size()<<endl;
+
+        BeginTextureMode(pathDrawings);
+        ClearBackground(BLANK);
+        unsigned int pathsize=pathPoints_first_float.size();
+        for (unsigned int i=0;i<pathsize-1;i++) {
+            DrawLine(pathPoints_first_float[i].x,pathPoints_first_float[i].y,pathPoints_first_float[i+1].x,pathPoints_first_float[i+1].y,BLUE);
+            DrawLine(pathPoints_second_float[i].x,pathPoints_second_float[i].y,pathPoints_second_float[i+1].x,pathPoints_second_float[i+1].y,RED);
+            DrawLine(pathPoints_third_float[i].x,pathPoints_third_float[i].y,pathPoints_third_float[i+1].x,pathPoints_third_float[i+1].y,YELLOW);
+        }
+        DrawLine(pathPoints_first_float[pathsize-2].x,pathPoints_first_float[pathsize-2].y,pathPoints_first_float[pathsize-1].x,pathPoints_first_float[pathsize-1].y,BLUE);
+        DrawLine(pathPoints_second_float[pathsize-2].x,pathPoints_second_float[pathsize-2].y,pathPoints_second_float[pathsize-1].x,pathPoints_second_float[pathsize-1].y,RED);
+        DrawLine(pathPoints_third_float[pathsize-2].x,pathPoints_third_float[pathsize-2].y,pathPoints_third_float[pathsize-1].x,pathPoints_third_float[pathsize-1].y,YELLOW);
+        EndTextureMode();
+        drawThreePaths=false;
+    } //End-if drawThreePaths
+
+    //Prints basic stats about the differences between the types shown on the difference screen just selected.  The maps and their stats are kept up to
+    //date by the workers as points finish, so there is nothing to calculate here.
+    if (printDifference) {
+        int pair=(displayScreen==5)?1:((displayScreen==6)?2:0);
+        DifferenceStats stats=differences.Total(pair);
+        cout<<"Difference stats of "<<differenceNames[pair]<<":\nDifferent pixels: "<<stats.count<<" ("<<(float)stats.count/(10.24f*1024.0f)<<"%)\nMax diff: "<<stats.max<<" Min diff: "<<stats.min<<endl;
+        printDifference=false;
+    } // End-if printDifference
+
+    //Types on each screen, for SchedulePolicy::DisplayedFirst.  Screen 7 shows the first two types and their difference.
+    const unsigned int screenTypes[9]={0,1,2,4,3,5,6,3,1};
+    scheduler.SetDisplayedTypes(screenTypes[displayScreen]);
+
+    // Pausing stops the workers from starting new batches.  Batches already running finish and are still drawn.
+    if (pauseCalc!=poolPaused) {
+        pool.SetPaused(pauseCalc);
+        poolPaused=pauseCalc;
+    }
+
+    // Fetch the ranges of points the workers have finished since the last frame.  (Iteration values have been updated directly by the workers since each batch owns its own points.)
+    // Types rendered by Mariani-Silver or progressively count their own pending tasks; the rest are counted by the scheduler.  The count is read before
+    // fetching, so that once it reads 0 every range has been fetched.
+    workPending_first_float=marianiSilverRunning_first_float?msStats_first_float.rectsPending.load():(progressiveRunning_first_float?progressiveStats_first_float.tasksPending.load():scheduler.Pending(1));
+    completedRanges_first_float.TakeAll(rangesToDraw_first_float);
+    completedTiles_first_float.TakeAll(tilesToDraw_first_float);
+    if (!rangesToDraw_first_float.empty()) drawIter_first_float=rangesToDraw_first_float.back();
+    if (!tilesToDraw_first_float.empty()) drawIter_first_float=tileGrid.Row(tilesToDraw_first_float.back().tile,0);
+    workPending_second_float=marianiSilverRunning_second_float?msStats_second_float.rectsPending.load():(progressiveRunning_second_float?progressiveStats_second_float.tasksPending.load():scheduler.Pending(2));
+    completedRanges_second_float.TakeAll(rangesToDraw_second_float);
+    completedTiles_second_float.TakeAll(tilesToDraw_second_float);
+    if (!rangesToDraw_second_float.empty()) drawIter_second_float=rangesToDraw_second_float.back();
+    if (!tilesToDraw_second_float.empty()) drawIter_second_float=tileGrid.Row(tilesToDraw_second_float.back().tile,0);
+    workPending_third_float=marianiSilverRunning_third_float?msStats_third_float.rectsPending.load():(progressiveRunning_third_float?progressiveStats_third_float.tasksPending.load():scheduler.Pending(3));
+    completedRanges_third_float.TakeAll(rangesToDraw_third_float);
+    completedTiles_third_float.TakeAll(tilesToDraw_third_float);
+    if (!rangesToDraw_third_float.empty()) drawIter_third_float=rangesToDraw_third_float.back();
+    if (!tilesToDraw_third_float.empty()) drawIter_third_float=tileGrid.Row(tilesToDraw_third_float.back().tile,0);
+
+
+    //Update the textures from the framebuffers.  We also update our progress stats here.
+    MSET_TRACE_BEGIN(drawPointsSpan,"draw new points");
+    numPointsUpdated=0;
+
+    //For our first type.  Tiles were colored by the workers that finished them; ranges are colored here.
+    for (const IndexRange &range:rangesToDraw_first_float) {  //Plot points for index ranges fetched above
+        paintFinishedRange(framebuffer_first_float,pointsToCalc_first_float,range,progressiveRunning_first_float);
+        differences.UpdateRange(1,pointsToCalc_first_float.iterations.data(),range);
+        numPointsUpdated+=(unsigned int)range.Size();  //Update stats
+    }
+    for (const TileResult &tile:tilesToDraw_first_float) {
+        framebuffer_first_float.MarkTile(tile.tile);
+        numPointsUpdated+=tile.points;
+    }
+    uploadFramebuffer(framebuffer_first_float,msetTexture_first_float);
+    rangesToDraw_first_float.clear(); // Clear vectors since these points have been plotted now
+    tilesToDraw_first_float.clear();
+
+    //Same for our second type
+    for (const IndexRange &range:rangesToDraw_second_float) {
+        paintFinishedRange(framebuffer_second_float,pointsToCalc_second_float,range,progressiveRunning_second_float);
+        differences.UpdateRange(2,pointsToCalc_second_float.iterations.data(),range);
+        numPointsUpdated+=(unsigned int)range.Size();
+    }
+    for (const TileResult &tile:tilesToDraw_second_float) {
+        framebuffer_second_float.MarkTile(tile.tile);
+        numPointsUpdated+=tile.points;
+    }
+    uploadFramebuffer(framebuffer_second_float,msetTexture_second_float);
+    rangesToDraw_second_float.clear();
+    tilesToDraw_second_float.clear();
+
+    //Same for our third type
+    for (const IndexRange &range:rangesToDraw_third_float) {
+        paintFinishedRange(framebuffer_third_float,pointsToCalc_third_float,range,progressiveRunning_third_float);
+        differences.UpdateRange(3,pointsToCalc_third_float.iterations.data(),range);
+        numPointsUpdated+=(unsigned int)range.Size();
+    }
+    for (const TileResult &tile:tilesToDraw_third_float) {
+        framebuffer_third_float.MarkTile(tile.tile);
+        numPointsUpdated+=tile.points;
+    }
+    uploadFramebuffer(framebuffer_third_float,msetTexture_third_float);
+    rangesToDraw_third_float.clear();
+    tilesToDraw_third_float.clear();
+
+    //The difference maps, whichever screen is shown, so that switching to one is instant
+    uploadDifferences(0,diffScreen2M1);
+    uploadDifferences(1,diffScreen3M1);
+    uploadDifferences(2,diffScreen3M2);
+
+    //Update the other stats now that we know how many points we have plotted for all three types
+    numPointsFinished+=numPointsUpdated;
+    numPointsToCalc-=numPointsUpdated;
+    MSET_TRACE_END(drawPointsSpan);
+
+    //Draw everything to the screen
+    MSET_TRACE_BEGIN(drawScreenSpan,"draw screen");
+    BeginDrawing();
+    ClearBackground(BLACK);
+    DrawFPS(1030,5);
+
+    //Compose what we draw according to the display screen mode selected
+    if (displayScreen==1) {
+        DrawTextureRec(msetTexture_first_float,imageRec,origin,WHITE);
+        //Draw small rectangle to indicate progress
+        if (workPending_first_float>0) {
+            int_vector2 gp=pointsToCalc_first_float.GridPos(drawIter_first_float.start);
+            DrawRectangle(gp.x,gp.y,3,3,Fade(WHITE,0.8));
+        }
+        DrawText("First type",1030,50,20,WHITE);
+    }
+    if (displayScreen==2) {
+        DrawTextureRec(msetTexture_second_float,imageRec,origin,WHITE);
+        //Draw small rectangle to indicate progress
+        if (workPending_second_float>0) {
+            int_vector2 gp=pointsToCalc_second_float.GridPos(drawIter_second_float.start);
+            DrawRectangle(gp.x,gp.y,3,3,Fade(WHITE,0.8));
+        }
+        DrawText("Second type",1030,50,20,WHITE);
+    }
+    if (displayScreen==3) {
+        DrawTextureRec(msetTexture_third_float,imageRec,origin,WHITE);
+        //Draw small rectangle to indicate progress
+        if (workPending_third_float>0) {
+            int_vector2 gp=pointsToCalc_third_float.GridPos(drawIter_third_float.start);
+            DrawRectangle(gp.x,gp.y,3,3,Fade(WHITE,0.8));
+        }
+        DrawText("Third type",1030,50,20,WHITE);
+    }
+    if (displayScreen==4) {
+        DrawTextureRec(diffScreen2M1,imageRec,origin,WHITE);
+        DrawText("Difference",1030,50,20,WHITE);
+        DrawText("Type 2 - Type 1",1035,80,16,WHITE);
+    }
+    if (displayScreen==5) {
+        DrawTextureRec(diffScreen3M1,imageRec,origin,WHITE);
+        DrawText("Difference",1030,50,20,WHITE);
+        DrawText("Type 3 - Type 1",1035,80,16,WHITE);
+    }
+    if (displayScreen==6) {
+        DrawTextureRec(diffScreen3M2,imageRec,origin,WHITE);
+        DrawText("Difference",1030,50,20,WHITE);
+        DrawText("Type 3 - Type 2",1035,80,16,WHITE);
+    }
+    if ((displayScreen>=4) && (displayScreen<=6)) {  //Stats as the maps update, the same as printed to the console
+        DifferenceStats stats=differences.Total(displayScreen-4);
+        snprintf(smallText,40,"Different: %u",stats.count);
+        DrawText(smallText,1035,110,16,WHITE);
+        snprintf(smallText,40,"(%.3f%%)",stats.count/(10.24*1024.0));
+        DrawText(smallText,1035,130,16,WHITE);
+        snprintf(smallText,40,"Max diff: %i",stats.max);
+        DrawText(smallText,1035,150,16,WHITE);
+        snprintf(smallText,40,"Min diff: %i",stats.min);
+        DrawText(smallText,1035,170,16,WHITE);
+    }
+    if (displayScreen==7) {
+        DrawTexturePro(msetTexture_first_float,imageRec,{0.0,0.0,512.0f,512.0f},origin,0,WHITE);
+        DrawTexturePro(msetTexture_second_float,imageRec,{512.0,0.0,512.0f,512.0f},origin,0,WHITE);
+        DrawTexturePro(diffScreen2M1,imageRec,{0.0,512.0,512.0f,512.0f},origin,0,WHITE);
+        DrawTexturePro(msetCanvas,imageRec,{512.0,512.0,512.0f,512.0f},origin,0,Fade(WHITE,0.5));
+        DrawTexturePro(pathDrawings.texture,flipRec,{512.0,512.0,512.0f,512.0f},origin,0,WHITE);
+    }
+    if (displayScreen==8) {
+        //DrawTextureRec(msetCanvas,imageRec,origin,Fade(WHITE,0.5));
+        DrawTextureRec(msetTexture_first_float,imageRec,origin,WHITE);
+        DrawTextureRec(pathDrawings.texture,flipRec,origin,WHITE);
+    }
+
+    //Draws a small rectangle to indicate the exact center of the screen.  Useful for zooming.
+    if (highlightCenterOfScreen) DrawRectangle(511,511,3,3,Fade(WHITE,0.8));
+
+    if (showGrid) { // To help estimate orbit positions on the screen and for estimating zoom by factors of two or eight
+        DrawCircleLines(512,512,64,Fade(GRAY,0.5));  //Circles at radius 1/4, 1/2, 3/4 and 1
+        DrawCircleLines(512,512,128,Fade(GRAY,0.5));
+        DrawCircleLines(512,512,192,Fade(GRAY,0.5));
+        DrawCircleLines(512,512,256,Fade(LIGHTGRAY,0.5));
+        DrawRectangleLines(256,256,512,512,Fade(LIGHTGRAY,0.5)); // Rectangle from (-1,-1) to (1,1)
+        DrawCircleLines(512,512,512,Fade(GRAY,0.5));
+        DrawLine(0,0,1023,1023,Fade(GRAY,0.5));
+        DrawLine(0,1023,1023,0,Fade(GRAY,0.5));
+    }
+
+    //Update sidebar info
+    DrawText("Max iterations:",1030,650,20,WHITE);
+    DrawText(PrintNum(smallText,maxIterations),1035,680,20,WHITE);
+
+    DrawText("Pixel delta is",1030,710,20,WHITE);
+    snprintf(smallText,40,"2^%u",zoomDenomPower);
+    DrawText(smallText,1035,740,20,WHITE);
+
+    if (pauseCalc) DrawText("Paused.",1030,770,20,YELLOW);
+
+    if ( PeriodicityCheckEnabled() && (displayScreen>=1) && (displayScreen<=3) ) {
+        unsigned long long periodicPoints=(displayScreen==1)?PeriodicPoints<first_float>().load():((displayScreen==2)?PeriodicPoints<second_float>().load():PeriodicPoints<third_float>().load());
+        snprintf(smallText,40,"Periodic: %llu",periodicPoints);
+        DrawText(smallText,1035,505,16,GRAY);
+    }
+    if ( InteriorTestEnabled() && (displayScreen>=1) && (displayScreen<=3) ) {
+        unsigned long long interiorPoints=(displayScreen==1)?InteriorTestPoints<first_float>().load():((displayScreen==2)?InteriorTestPoints<second_float>().load():InteriorTestPoints<third_float>().load());
+        snprintf(smallText,40,"Bulb test: %llu",interiorPoints);
+        DrawText(smallText,1035,480,16,GRAY);
+    }
+
+    if ( (marianiSilverRunning_first_float && (displayScreen==1)) || (marianiSilverRunning_second_float && (displayScreen==2)) || (marianiSilverRunning_third_float && (displayScreen==3)) ) {
+        MarianiSilverStats &stats=(displayScreen==1)?msStats_first_float:((displayScreen==2)?msStats_second_float:msStats_third_float);
+        snprintf(smallText,40,"Rect fill: %llu",stats.filledPoints.load());
+        DrawText(smallText,1035,430,16,GRAY);
+        if (verifyMarianiSilver) {
+            snprintf(smallText,40,"Fill mismatches: %llu",stats.fillMismatches.load());
+            DrawText(smallText,1035,455,16,(stats.fillMismatches>0)?ORANGE:GRAY);
+        }
+    }
+    if ( (usePerturbation_second_float && (displayScreen==2)) || (usePerturbation_third_float && (displayScreen==3)) ) {
+        PerturbationStats &stats=(displayScreen==2)?perturbStats_second_float:perturbStats_third_float;
+        DrawText("Perturbation",1030,530,20,SKYBLUE);
+        snprintf(smallText,40,"Ref orbit: %i",stats.referenceLength.load());
+        DrawText(smallText,1035,560,16,SKYBLUE);
+        snprintf(smallText,40,"Rebases: %llu",stats.rebases.load());
+        DrawText(smallText,1035,585,16,SKYBLUE);
+        snprintf(smallText,40,"Series skip: %i",stats.seriesSkip.load());
+        DrawText(smallText,1035,610,16,SKYBLUE);
+        if (zoomDenomPower>=extendedRangeZoomDenomPower) DrawText("Extended range",1035,630,16,SKYBLUE);
+    }
+
+    DrawText("Points Finished:",1030,800,20,GREEN);
+    DrawText(PrintNum(smallText,numPointsFinished),1035,830,20,GREEN);
+    DrawText("Updated:",1030,860,20,GREEN);
+    DrawText(PrintNum(smallText,numPointsUpdated),1035,890,20,GREEN);
+    DrawText("Remaining:",1030,920,20,GREEN);
+    DrawText(PrintNum(smallText,numPointsToCalc),1035,950,20,GREEN);
+#if MSET_TRACE
+    if (GetTime()-iterationRateTime>=0.5) {
+        double now=GetTime();
+        for (int t=0;t<3;t++) {
+            unsigned long long count=TraceIterations(t+1);
+            iterationsPerSecond[t]=(count-iterationRateCount[t])/(now-iterationRateTime);
+            iterationRateCount[t]=count;
+        }
+        iterationRateTime=now;
+    }
+    for (int t=0;t<3;t++) {
+        snprintf(smallText,40,"Iter/s %i: %.3g",t+1,iterationsPerSecond[t]);
+        DrawText(smallText,1035,975+15*t,14,GREEN);
+    }
+#endif
+
+    EndDrawing();
+    MSET_TRACE_END(drawScreenSpan);
+
+    } //End main loop white
+
+    //Clean-up.  RayLib requires that we unload all textures.
+    UnloadTexture(msetTexture_first_float);
+    UnloadTexture(msetTexture_second_float);
+    UnloadTexture(msetTexture_third_float);
+    UnloadTexture(diffScreen2M1);
+    UnloadTexture(diffScreen3M1);
+    UnloadTexture(diffScreen3M2);
+    UnloadRenderTexture(pathDrawings);
+    UnloadTexture(msetCanvas);
+    CloseWindow();
+    return 0;
+}
@@ -0,0 +1,346 @@
+//Headless batch renderer.  Computes the same images as the RayLib explorer in main.cpp, but from the command line and without a window,
+//so renders can be scripted on compute nodes and timed without render-loop overhead.  Iteration buffers and difference maps are written to disk.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <climits>
+
+#include "msetCore.hpp"
+#include "msetPrecisions.hpp"
+#include "msetSimd.hpp"
+#include "msetThreadPool.hpp"
+#include "msetPerturbation.hpp"
+#include "msetMarianiSilver.hpp"
+#include "msetProgressive.hpp"
+
+using namespace std;
+
+//Settings for one headless run, filled in from the command line
+struct BatchRenderOptions {
+    string centerReal="0";
+    string centerImag="0";
+    unsigned int zoomDenomPower=8;
+    int maxIterations=100;
+    int resolution=1024;
+    string types="123";
+    vector<string> precisions;  //If set, these precisions by name instead of the three types
+    unsigned int numThreads=0;  //0 = one per hardware thread
+    string outPrefix="mset";
+    bool writeRaw=true;
+    bool writeImage=true;
+    SimdLevel simdLimit=simdAVX512;
+    bool perturbation=false;  //Render types 2 and 3 by perturbation around a reference orbit at the center
+    int seriesOrder=8;        //Terms in the series approximation used with perturbation.  0 = off
+    bool periodicityCheck=true;  //Stop points whose orbit has settled into a cycle
+    bool interiorTest=true;      //Skip points in the main cardioid and the largest bulbs
+    string marianiSilverTypes="";  //Types rendered by Mariani-Silver rectangle subdivision instead of every pixel
+    bool verifyFill=false;         //With Mariani-Silver, also iterate filled pixels and count mismatches
+    bool progressive=false;        //Compute coarse to fine, as the explorer's progressive mode does.  Same result, for timing the overhead.
+    int resumeFrom=0;              //If set, first render with this many max iterations, then time resuming to maxIterations.  0 = off
+};
+
+void PrintUsage(const char* progName) {
+    cout<<"Usage: "<<progName<<" [options]\n"
+        <<"  --center <real> <imag>   Center of the image.  Parsed separately by each type, so keep all the digits you need (default 0 0)\n"
+        <<"  --zoom <n>               zoomDenomPower: pixel delta is 1/2^n (default 8)\n"
+        <<"  --maxiter <n>            Max iterations (default 100)\n"
+        <<"  --res <n>                Image width and height in pixels, even number (default 1024)\n"
+        <<"  --types <list>           Which float types to run, e.g. 1, 13 or 123 (default 123)\n"
+        <<"  --precisions <a,b,...>   Run these precisions instead of the three types, compared in the order given.  The nth one stands in for type n\n"
+        <<"                           in --mariani and --perturb.  Any of:";
+    for (const string &name:PrecisionNames(EnginePrecisions())) cout<<" "<<name;
+    cout<<"\n"
+        <<"  --threads <n>            Worker threads (default: all cores)\n"
+        <<"  --out <prefix>           Output file prefix (default mset)\n"
+        <<"  --format <raw|pgm|both>  raw = native-endian int32 buffers, pgm = PGM/PPM images (default both)\n"
+        <<"  --simd <off|avx2|avx512> Widest vector kernel to use for double kernels (default: widest the CPU supports)\n"
+        <<"  --perturb                Render types 2 and 3 by perturbation: one reference orbit in the type's precision, pixel deltas in double\n"
+        <<"  --series <n>             Terms of the series approximation that skips early iterations with --perturb, 0 = off (default 8)\n"
+        <<"  --periodicity <on|off>   Stop iterating points whose orbit has settled into a cycle (default on)\n"
+        <<"  --interior <on|off>      Skip points in the main cardioid, the period-2 bulb and a few other large bulbs (default on)\n"
+        <<"  --mariani <list>         Render these types by Mariani-Silver subdivision, filling rectangles with a uniform border, e.g. 1 or 123 (default none)\n"
+        <<"  --verify-fill            With --mariani, also iterate every filled pixel and report how many the fill got wrong\n"
+        <<"  --progressive            Compute every 16th pixel first, then halve the spacing down to every pixel (types not using --mariani)\n"
+        <<"  --resume-from <n>        First render with n max iterations (not timed), then time raising or lowering to --maxiter by resuming the saved orbits\n";
+}
+
+//Returns false on bad input
+bool ParseOptions(int argc, char* argv[], BatchRenderOptions &opt) {
+    try {
+        for (int i=1;i<argc;i++) {
+            string arg=argv[i];
+            bool hasNext=(i+1<argc);
+            if ((arg=="--center")&&(i+2<argc)) { opt.centerReal=argv[i+1]; opt.centerImag=argv[i+2]; i+=2; }
+            else if ((arg=="--zoom")&&hasNext) { opt.zoomDenomPower=(unsigned int)stoul(argv[++i]); }
+            else if ((arg=="--maxiter")&&hasNext) { opt.maxIterations=stoi(argv[++i]); }
+            else if ((arg=="--res")&&hasNext) { opt.resolution=stoi(argv[++i]); }
+            else if ((arg=="--types")&&hasNext) { opt.types=argv[++i]; }
+            else if ((arg=="--precisions")&&hasNext) {
+                istringstream list(argv[++i]);
+                string name;
+                while (getline(list,name,',')) opt.precisions.push_back(name);
+            }
+            else if ((arg=="--threads")&&hasNext) { opt.numThreads=(unsigned int)stoul(argv[++i]); }
+            else if ((arg=="--out")&&hasNext) { opt.outPrefix=argv[++i]; }
+            else if (arg=="--perturb") { opt.perturbation=true; }
+            else if ((arg=="--mariani")&&hasNext) { opt.marianiSilverTypes=argv[++i]; }
+            else if (arg=="--verify-fill") { opt.verifyFill=true; }
+            else if (arg=="--progressive") { opt.progressive=true; }
+            else if ((arg=="--resume-from")&&hasNext) { opt.resumeFrom=stoi(argv[++i]); }
+            else if ((arg=="--series")&&hasNext) { opt.seriesOrder=stoi(argv[++i]); }
+            else if ((arg=="--periodicity")&&hasNext) {
+                string f=argv[++i];
+                if ((f!="on")&&(f!="off")) return false;
+                opt.periodicityCheck=(f=="on");
+            }
+            else if ((arg=="--interior")&&hasNext) {
+                string f=argv[++i];
+                if ((f!="on")&&(f!="off")) return false;
+                opt.interiorTest=(f=="on");
+            }
+            else if ((arg=="--simd")&&hasNext) {
+                string f=argv[++i];
+                if (f=="off") opt.simdLimit=simdScalar;
+                else if (f=="avx2") opt.simdLimit=simdAVX2;
+                else if (f=="avx512") opt.simdLimit=simdAVX512;
+                else return false;
+            }
+            else if ((arg=="--format")&&hasNext) {
+                string f=argv[++i];
+                opt.writeRaw=(f=="raw")||(f=="both");
+                opt.writeImage=(f=="pgm")||(f=="both");
+                if (!opt.writeRaw && !opt.writeImage) return false;
+            }
+            else return false;
+        }
+    }
+    catch (const std::exception &) { return false; }  //stoi and friends throw on non-numeric input
+    if ((opt.resolution<2)||(opt.resolution%2)) return false;
+    if ((opt.maxIterations<2)||(opt.zoomDenomPower>(unsigned int)INT_MAX)||(opt.seriesOrder<0)||(opt.resumeFrom<0)) return false;
+    for (char c:opt.types) if ((c<'1')||(c>'3')) return false;
+    for (char c:opt.marianiSilverTypes) if ((c<'1')||(c>'9')) return false;
+    vector<string> known=PrecisionNames(EnginePrecisions());
+    for (const string &name:opt.precisions) if (find(known.begin(),known.end(),name)==known.end()) return false;
+    return true;
+}
+
+//Reads a decimal string into any of our float types, at that type's own precision
+template<class FloatType> FloatType ParseFloat(const string &s) {
+    FloatType f;
+    istringstream iss(s);
+    iss>>f;
+    return f;
+}
+
+//Fills a point store for one precision, runs it through that precision's msetBatchSimd kernel on the pool's workers and returns the iteration buffer in row-major order.
+//If perturbStats is given the type is rendered by perturbation instead: the reference orbit is part of the calc time, and per-pixel coordinates are never generated.
+//If msStats is given the type is rendered by Mariani-Silver subdivision using the same kernel.  Otherwise opt.progressive computes it coarse to fine.
+//With opt.resumeFrom, a first pass at that many max iterations counts as setup, and the calc time is for carrying the saved orbits on to maxIterations.
+template<class Float>
+vector<int> RenderType(ThreadPool &pool, MyComplex<Float> coordCenter, const BatchRenderOptions &opt, unsigned int batchSize,
+                       double &setupSeconds, double &calcSeconds, size_t &storeBytes, PerturbationStats *perturbStats=nullptr, MarianiSilverStats *msStats=nullptr) {
+    int res=opt.resolution;
+    unsigned int zoomDenomPower=opt.zoomDenomPower;
+    typedef PointStore<Float> StoreType;
+    IndexRange (*msetBatch)(StoreType&, IndexRange, int, CancelToken)=msetBatchSimd<Float>;
+    auto t0=chrono::steady_clock::now();
+    StoreType pointsToCalc(res);
+    pointsToCalc.SetView(coordCenter,zoomDenomPower);
+    pointsToCalc.InvalidateCoords();  //Coordinates are generated by the kernels, so they count towards the calc time
+    storeBytes=pointsToCalc.MemoryBytes();
+
+    PerturbationFrame frame;
+    ResultQueue<IndexRange> completedRanges;  //Mariani-Silver and progressive rendering report their ranges here.  Nothing to draw, so they are dropped.
+    ProgressiveStats progressiveStats;
+    auto renderPass=[&](int maxIterations) {
+        if (perturbStats) {
+            frame.Compute(coordCenter,maxIterations,zoomDenomPower,res/2,opt.seriesOrder,CancelToken());
+            perturbStats->referenceLength=frame.ref.Length();
+            perturbStats->seriesSkip=frame.SeriesSkip();
+        }
+        if (msStats) {
+            msStats->Reset();
+            StartMarianiSilver<StoreType>(pointsToCalc,res,{{0,pointsToCalc.Size()}},[maxIterations,msetBatch](StoreType &points, IndexRange range) { return msetBatch(points,range,maxIterations,CancelToken()); },
+                                                       CancelToken(),pool,completedRanges,*msStats,opt.verifyFill);
+        }
+        else if (opt.progressive) {
+            if (perturbStats) StartProgressive<StoreType>(pointsToCalc,res,[maxIterations,&frame,perturbStats](StoreType &points, IndexRange range) { return frame.Batch(points,range,maxIterations,CancelToken(),perturbStats); },
+                                                         CancelToken(),pool,completedRanges,progressiveStats,batchSize);
+            else StartProgressive<StoreType>(pointsToCalc,res,[maxIterations,msetBatch](StoreType &points, IndexRange range) { return msetBatch(points,range,maxIterations,CancelToken()); },
+                                             CancelToken(),pool,completedRanges,progressiveStats,batchSize);
+        }
+        for (size_t b=0;(b<pointsToCalc.Size())&&!msStats&&!opt.progressive;b+=batchSize) {
+            IndexRange batch={b,std::min(b+batchSize,pointsToCalc.Size())};
+            if (perturbStats) pool.Submit([batch,maxIterations,&frame,perturbStats,&pointsToCalc]() { frame.Batch(pointsToCalc,batch,maxIterations,CancelToken(),perturbStats); });
+            else pool.Submit([batch,maxIterations,msetBatch,&pointsToCalc]() { msetBatch(pointsToCalc,batch,maxIterations,CancelToken()); });
+        }
+        pool.WaitIdle();
+        completedRanges.Clear();
+    };
+    if (opt.resumeFrom>0) renderPass(opt.resumeFrom);
+    auto t1=chrono::steady_clock::now();
+    renderPass(opt.maxIterations);
+    auto t2=chrono::steady_clock::now();
+
+    setupSeconds=chrono::duration<double>(t1-t0).count();
+    calcSeconds=chrono::duration<double>(t2-t1).count();
+    return std::move(pointsToCalc.iterations);
+}
+
+bool WriteRaw(const string &fileName, const vector<int> &buffer) {
+    ofstream out(fileName,ios::binary);
+    out.write((const char*)buffer.data(),buffer.size()*sizeof(int));
+    return out.good();
+}
+
+//16-bit greyscale PGM of iteration counts, clamped to 65535.  Interior points (iterations=0) are black as on screen.
+bool WriteIterationPGM(const string &fileName, const vector<int> &buffer, int res) {
+    ofstream out(fileName,ios::binary);
+    out<<"P5\n"<<res<<" "<<res<<"\n65535\n";
+    for (int v:buffer) {
+        uint16_t p=(uint16_t)(v<0?0:(v>65535?65535:v));
+        unsigned char be[2]={(unsigned char)(p>>8),(unsigned char)(p&0xFF)};  //PGM samples are big-endian
+        out.write((const char*)be,2);
+    }
+    return out.good();
+}
+
+//Colour PPM of a difference map using the same red/green scheme as colorizePixelDiff in main.cpp
+bool WriteDifferencePPM(const string &fileName, const vector<int> &diff, int res) {
+    ofstream out(fileName,ios::binary);
+    out<<"P6\n"<<res<<" "<<res<<"\n255\n";
+    for (int i:diff) {
+        unsigned char rgb[3]={0,0,0};
+        if (i>0) rgb[1]=(unsigned char)(128+31*(i%4));
+        if (i<0) rgb[0]=(unsigned char)(128+31*((-i)%4));
+        out.write((const char*)rgb,3);
+    }
+    return out.good();
+}
+
+//Iteration buffer of one finished render, kept for the difference maps
+struct RenderedImage {
+    int slot;        //Type number, or position in --precisions
+    string label;    //Type N, or the precision's name
+    string fileTag;  //typeN, or the precision's name
+    vector<int> iterations;
+};
+
+int main(int argc, char* argv[])
+{
+    BatchRenderOptions opt;
+    if (!ParseOptions(argc,argv,opt)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // OPTION: Change batch size for the three types here.  Same defaults as the RayLib explorer.  With --precisions, each precision gets the size of the type
+    // closest to it in cost.
+    unsigned int batchSize_first_float=10240;
+    unsigned int batchSize_second_float=5120;
+    unsigned int batchSize_third_float=1024;
+
+    ThreadPool pool(opt.numThreads);
+    LimitSimdLevel(opt.simdLimit);
+    PeriodicityCheckEnabled()=opt.periodicityCheck;
+    InteriorTestEnabled()=opt.interiorTest;
+    SetPeriodicityTolerance(opt.zoomDenomPower);
+
+    cout<<setprecision(33);
+    cout<<"Center: "<<opt.centerReal<<" + "<<opt.centerImag<<" i  Pixel delta: 1/2^"<<opt.zoomDenomPower<<"  Max iterations: "<<opt.maxIterations
+        <<"  Resolution: "<<opt.resolution<<"x"<<opt.resolution<<"  Threads: "<<pool.Size()<<"  double kernel: "<<SimdLevelName(ActiveSimdLevel())<<endl;
+
+    vector<RenderedImage> images;
+    size_t numPixels=(size_t)opt.resolution*opt.resolution;
+
+    //Renders one precision standing in for type number slot (1-based), reports on it and writes its buffers
+    auto run=[&](auto tag, int slot, const string &label, const string &fileTag, unsigned int batchSize) {
+        typedef typename decltype(tag)::type Float;
+        double setupSeconds=0, calcSeconds=0;
+        size_t storeBytes=0;
+        PerturbationStats perturbStats;
+        MarianiSilverStats msStats;
+        bool usePerturbation=opt.perturbation && (slot>1);
+        bool useMarianiSilver=(opt.marianiSilverTypes.find((char)('0'+slot))!=string::npos) && !usePerturbation;  //Perturbation takes precedence
+        PeriodicPoints<Float>()=0;
+        InteriorTestPoints<Float>()=0;
+
+        MyComplex<Float> center(ParseFloat<Float>(opt.centerReal),ParseFloat<Float>(opt.centerImag));
+        vector<int> iterations=RenderType<Float>(pool,center,opt,usePerturbation?batchSize_first_float:batchSize,setupSeconds,calcSeconds,storeBytes,
+                                                 usePerturbation?&perturbStats:nullptr,useMarianiSilver?&msStats:nullptr);
+
+        long long totalIterations=0;
+        for (int v:iterations) totalIterations+=v;  //Escaped points only, interior points are stored as 0
+        cout<<label<<": setup "<<setprecision(4)<<setupSeconds<<" s, calc "<<calcSeconds<<" s, "
+            <<(double)numPixels/calcSeconds<<" pixels/s, "<<(double)totalIterations/calcSeconds<<" escaped-point iterations/s"<<setprecision(33)<<endl;
+        cout<<"  Point store: "<<setprecision(4)<<storeBytes/1048576.0<<" MB"<<setprecision(33)<<endl;
+        if (opt.periodicityCheck) cout<<"  Periodicity check stopped "<<PeriodicPoints<Float>()<<" interior points early"<<endl;
+        if (opt.interiorTest && !usePerturbation) cout<<"  Interior test skipped "<<InteriorTestPoints<Float>()<<" points"<<endl;
+        if (usePerturbation) {
+            cout<<"  Perturbation: reference orbit "<<perturbStats.referenceLength<<" iterations, "<<perturbStats.rebases<<" rebases, series skipped "<<perturbStats.seriesSkip<<" iterations"<<endl;
+        }
+        if (useMarianiSilver) {
+            cout<<"  Mariani-Silver: filled "<<msStats.filledPoints<<" points ("<<setprecision(4)<<100.0*msStats.filledPoints/numPixels<<"%)"<<setprecision(33);
+            if (opt.verifyFill) cout<<", "<<msStats.fillMismatches<<" fill mismatches against brute force";
+            cout<<endl;
+        }
+
+        string base=opt.outPrefix+"_"+fileTag;
+        if (opt.writeRaw && !WriteRaw(base+".raw",iterations)) cerr<<"Error writing "<<base<<".raw"<<endl;
+        if (opt.writeImage && !WriteIterationPGM(base+".pgm",iterations,opt.resolution)) cerr<<"Error writing "<<base<<".pgm"<<endl;
+        images.push_back({slot,label,fileTag,std::move(iterations)});
+    };
+
+    if (!opt.precisions.empty()) {
+        for (size_t p=0;p<opt.precisions.size();p++) {
+            const string &name=opt.precisions[p];
+            DispatchPrecision(EnginePrecisions(),name,[&](auto tag) {
+                typedef typename decltype(tag)::type Float;
+                int digits=std::numeric_limits<Float>::digits;
+                unsigned int batchSize=(digits<=64)?batchSize_first_float:((digits<=128)?batchSize_second_float:batchSize_third_float);
+                run(tag,(int)p+1,name,name,batchSize);
+            });
+        }
+    }
+    else {
+        bool ran[3]={false,false,false};
+        for (char c:opt.types) {
+            int type=c-'1';
+            if (ran[type]) continue;
+            ran[type]=true;
+            string label="Type "+to_string(type+1), fileTag="type"+to_string(type+1);
+            if (type==0) run(PrecisionTag<first_float>(),1,label,fileTag,batchSize_first_float);
+            else if (type==1) run(PrecisionTag<second_float>(),2,label,fileTag,batchSize_second_float);
+            else run(PrecisionTag<third_float>(),3,label,fileTag,batchSize_third_float);
+        }
+    }
+
+    //Difference maps, same convention as screens 4, 5 and 6: 2M1 = type 2 - type 1, etc.  Precisions are numbered in the order given.
+    sort(images.begin(),images.end(),[](const RenderedImage &a, const RenderedImage &b) { return a.slot<b.slot; });
+    for (size_t h=1;h<images.size();h++) for (size_t l=0;l<h;l++) {
+        const RenderedImage &hi=images[h], &lo=images[l];
+        vector<int> diff(numPixels);
+        int pixeldiff_min=0, pixeldiff_max=0, pixeldiffCounter=0;
+        for (size_t i=0;i<numPixels;i++) {
+            diff[i]=hi.iterations[i]-lo.iterations[i];
+            if (diff[i]!=0) {
+                pixeldiffCounter++;
+                if (diff[i]>pixeldiff_max) pixeldiff_max=diff[i];
+                if (diff[i]<pixeldiff_min) pixeldiff_min=diff[i];
+            }
+        }
+        string name=opt.outPrefix+"_diff"+(opt.precisions.empty()?to_string(hi.slot)+"M"+to_string(lo.slot):"_"+hi.fileTag+"_M_"+lo.fileTag);
+        cout<<"Difference stats of "<<hi.label<<" - "<<lo.label<<":\nDifferent pixels: "<<pixeldiffCounter<<" ("<<setprecision(4)<<100.0*pixeldiffCounter/numPixels
+            <<"%)\nMax diff: "<<pixeldiff_max<<" Min diff: "<<pixeldiff_min<<setprecision(33)<<endl;
+        if (opt.writeRaw && !WriteRaw(name+".raw",diff)) cerr<<"Error writing "<<name<<".raw"<<endl;
+        if (opt.writeImage && !WriteDifferencePPM(name+".ppm",diff,opt.resolution)) cerr<<"Error writing "<<name<<".ppm"<<endl;
+    }
+
+    return 0;
+}
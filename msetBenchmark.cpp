@@ -0,0 +1,256 @@
+//Kernel benchmark.  Runs msetBatchSimd (and through it msetBatch and msetPoint) for each precision over a fixed set of named viewports, at several max
+//iterations and thread counts, and prints one record per run as CSV or JSON lines, so results can be kept, compared between versions and plotted.
+//Runs use the same point store, thread pool and kernels as the RayLib explorer and msetBatchRender, with nothing drawn or written but the records.
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <cmath>
+
+#include "msetCore.hpp"
+#include "msetSimd.hpp"
+#include "msetThreadPool.hpp"
+#include "msetPrecisions.hpp"
+
+using namespace std;
+
+//A fixed region of the plane.  The image is 2^-widthPower wide whatever the resolution, so runs at different resolutions cover the same region.
+struct Viewport {
+    const char *name;
+    const char *centerReal;
+    const char *centerImag;
+    int widthPower;
+};
+
+// OPTION: The named viewports.  Keep the names stable, since they are how records are matched between versions.
+const Viewport benchmarkViewports[]={
+    {"full_set", "-0.75", "0", -2},                   //The whole set, mostly fast exterior points and the cardioid
+    {"seahorse_valley", "-0.745", "0.11", 6},         //Mostly escaping points with long orbits near the boundary
+    {"deep_minibrot", "-1.74995768370609350360221450607069970727110579726252077930242837820286008082972804887218672784431700831100544507655659531379747541999999995",
+                      "0.00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001", 72},
+                                                      //A minibrot on the real axis at 2^-72, beyond what double can resolve
+    {"all_interior", "-0.1", "0", 4},                 //Inside the main cardioid.  Pass --interior off to time iterating it rather than the bulb test.
+    {"all_exterior", "1.5", "1.5", 1}                 //Every point escapes within a few iterations
+};
+
+//Settings for one benchmark session, filled in from the command line
+struct BenchmarkOptions {
+    vector<string> precisions={"double","double_double","cpp_bin_float_quad"};
+    vector<string> viewports;           //Empty = all
+    vector<int> maxIterations={256,1024,4096};
+    vector<unsigned int> threadCounts;  //Empty = 1, 2, 4, ... up to the hardware thread count
+    int resolution=256;
+    unsigned int batchSize=0;           //0 = the same size as the explorer's type of similar cost
+    int repeats=1;                      //Best of this many runs
+    bool json=false;
+    string label="";                    //Copied into every record, e.g. a version or machine name
+    SimdLevel simdLimit=simdAVX512;
+    bool periodicityCheck=true;
+    bool interiorTest=true;
+};
+
+void PrintUsage(const char* progName) {
+    cout<<"Usage: "<<progName<<" [options]\n"
+        <<"  --precisions <a,b,...>   Precisions to run (default double,double_double,cpp_bin_float_quad).  Any of:";
+    for (const string &name:PrecisionNames(EnginePrecisions())) cout<<" "<<name;
+    cout<<"\n"
+        <<"  --viewports <a,b,...>    Viewports to run (default all):";
+    for (const Viewport &v:benchmarkViewports) cout<<" "<<v.name;
+    cout<<"\n"
+        <<"  --maxiter <a,b,...>      Max iterations to run each viewport at (default 256,1024,4096)\n"
+        <<"  --threads <a,b,...>      Thread counts (default 1, 2, 4, ... up to the hardware thread count).  Scaling efficiency is relative to the first\n"
+        <<"  --res <n>                Image width and height in pixels, a power of two (default 256)\n"
+        <<"  --batch <n>              Points per batch (default 10240 for precisions up to 64 bits, 5120 up to 128 bits, 1024 beyond)\n"
+        <<"  --repeat <n>             Keep the fastest of n runs (default 1)\n"
+        <<"  --format <csv|json>      CSV with a header line, or one JSON object per line (default csv)\n"
+        <<"  --label <text>           Text for the label field of every record, e.g. a version\n"
+        <<"  --simd <off|avx2|avx512> Widest vector kernel to use for double (default: widest the CPU supports)\n"
+        <<"  --periodicity <on|off>   Periodicity check (default on)\n"
+        <<"  --interior <on|off>      Interior test for the main cardioid and the largest bulbs (default on)\n";
+}
+
+vector<string> SplitList(const string &list) {
+    vector<string> items;
+    istringstream in(list);
+    string item;
+    while (getline(in,item,',')) items.push_back(item);
+    return items;
+}
+
+//Returns false on bad input
+bool ParseOptions(int argc, char* argv[], BenchmarkOptions &opt) {
+    try {
+        for (int i=1;i<argc;i++) {
+            string arg=argv[i];
+            bool hasNext=(i+1<argc);
+            if ((arg=="--precisions")&&hasNext) { opt.precisions=SplitList(argv[++i]); }
+            else if ((arg=="--viewports")&&hasNext) { opt.viewports=SplitList(argv[++i]); }
+            else if ((arg=="--maxiter")&&hasNext) {
+                opt.maxIterations.clear();
+                for (const string &s:SplitList(argv[++i])) opt.maxIterations.push_back(stoi(s));
+            }
+            else if ((arg=="--threads")&&hasNext) {
+                opt.threadCounts.clear();
+                for (const string &s:SplitList(argv[++i])) opt.threadCounts.push_back((unsigned int)stoul(s));
+            }
+            else if ((arg=="--res")&&hasNext) { opt.resolution=stoi(argv[++i]); }
+            else if ((arg=="--batch")&&hasNext) { opt.batchSize=(unsigned int)stoul(argv[++i]); }
+            else if ((arg=="--repeat")&&hasNext) { opt.repeats=stoi(argv[++i]); }
+            else if ((arg=="--label")&&hasNext) { opt.label=argv[++i]; }
+            else if ((arg=="--format")&&hasNext) {
+                string f=argv[++i];
+                if ((f!="csv")&&(f!="json")) return false;
+                opt.json=(f=="json");
+            }
+            else if ((arg=="--simd")&&hasNext) {
+                string f=argv[++i];
+                if (f=="off") opt.simdLimit=simdScalar;
+                else if (f=="avx2") opt.simdLimit=simdAVX2;
+                else if (f=="avx512") opt.simdLimit=simdAVX512;
+                else return false;
+            }
+            else if ((arg=="--periodicity")&&hasNext) {
+                string f=argv[++i];
+                if ((f!="on")&&(f!="off")) return false;
+                opt.periodicityCheck=(f=="on");
+            }
+            else if ((arg=="--interior")&&hasNext) {
+                string f=argv[++i];
+                if ((f!="on")&&(f!="off")) return false;
+                opt.interiorTest=(f=="on");
+            }
+            else return false;
+        }
+    }
+    catch (const std::exception &) { return false; }  //stoi and friends throw on non-numeric input
+    if ((opt.resolution<2)||(opt.resolution&(opt.resolution-1))||(opt.repeats<1)) return false;
+    if (opt.label.find_first_of(",\"\\\n")!=string::npos) return false;  //Keeps both formats free of quoting
+    for (int m:opt.maxIterations) if (m<2) return false;
+    for (unsigned int t:opt.threadCounts) if (t==0) return false;
+    vector<string> known=PrecisionNames(EnginePrecisions());
+    for (const string &name:opt.precisions) if (find(known.begin(),known.end(),name)==known.end()) return false;
+    for (const string &name:opt.viewports) {
+        if (none_of(begin(benchmarkViewports),end(benchmarkViewports),[&](const Viewport &v) { return name==v.name; })) return false;
+    }
+    return true;
+}
+
+template<class FloatType> FloatType ParseFloat(const string &s) {
+    FloatType f;
+    istringstream iss(s);
+    iss>>f;
+    return f;
+}
+
+//Totals of one run
+struct RunResult {
+    double seconds=0;
+    unsigned long long iterations=0;  //Iterations of points that escaped or reached max iterations
+    unsigned long long periodicPoints=0;
+    unsigned long long interiorTestPoints=0;
+};
+
+//Renders one viewport from scratch on the pool and times it, coordinate generation included
+template<class Float>
+RunResult RunOnce(ThreadPool &pool, const Viewport &view, int res, int maxIterations, unsigned int batchSize) {
+    unsigned int zoomDenomPower=(unsigned int)(view.widthPower+(int)log2(res));
+    MyComplex<Float> center(ParseFloat<Float>(view.centerReal),ParseFloat<Float>(view.centerImag));
+    PointStore<Float> points(res);
+    SetPeriodicityTolerance(zoomDenomPower);
+    PeriodicPoints<Float>()=0;
+    InteriorTestPoints<Float>()=0;
+
+    auto t0=chrono::steady_clock::now();
+    points.SetView(center,zoomDenomPower);
+    points.InvalidateCoords();
+    for (size_t b=0;b<points.Size();b+=batchSize) {
+        IndexRange batch={b,std::min(b+batchSize,points.Size())};
+        pool.Submit([batch,maxIterations,&points]() { msetBatchSimd(points,batch,maxIterations); });
+    }
+    pool.WaitIdle();
+    auto t1=chrono::steady_clock::now();
+
+    RunResult result;
+    result.seconds=chrono::duration<double>(t1-t0).count();
+    for (int n:points.orbitIterations) if (n>0) result.iterations+=(unsigned long long)n;  //-1 marks interior points, whose iterations are not kept
+    result.periodicPoints=PeriodicPoints<Float>();
+    result.interiorTestPoints=InteriorTestPoints<Float>();
+    return result;
+}
+
+//Writes one record.  Field names are the same in both formats.
+void PrintRecord(const BenchmarkOptions &opt, const string &precision, const Viewport &view, int maxIterations, unsigned int threads, SimdLevel kernel,
+                 unsigned int batchSize, const RunResult &r, double scalingEfficiency) {
+    double pixels=(double)opt.resolution*opt.resolution;
+    const char *kernelName=(kernel==simdAVX512)?"avx512":((kernel==simdAVX2)?"avx2":"scalar");
+    ostringstream out;
+    out<<setprecision(6);
+    if (opt.json) {
+        out<<"{\"label\":\""<<opt.label<<"\",\"precision\":\""<<precision<<"\",\"viewport\":\""<<view.name<<"\",\"res\":"<<opt.resolution
+           <<",\"maxiter\":"<<maxIterations<<",\"threads\":"<<threads<<",\"kernel\":\""<<kernelName<<"\",\"batch\":"<<batchSize<<",\"seconds\":"<<r.seconds
+           <<",\"pixels_per_sec\":"<<pixels/r.seconds<<",\"iterations\":"<<r.iterations<<",\"iterations_per_sec\":"<<r.iterations/r.seconds
+           <<",\"periodic_points\":"<<r.periodicPoints<<",\"interior_test_points\":"<<r.interiorTestPoints<<",\"scaling_efficiency\":"<<scalingEfficiency<<"}";
+    }
+    else {
+        out<<opt.label<<","<<precision<<","<<view.name<<","<<opt.resolution<<","<<maxIterations<<","<<threads<<","<<kernelName<<","<<batchSize<<","<<r.seconds<<","
+           <<pixels/r.seconds<<","<<r.iterations<<","<<r.iterations/r.seconds<<","<<r.periodicPoints<<","<<r.interiorTestPoints<<","<<scalingEfficiency;
+    }
+    cout<<out.str()<<endl;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions opt;
+    if (!ParseOptions(argc,argv,opt)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if (opt.threadCounts.empty()) {
+        unsigned int hardwareThreads=std::max(1u,std::thread::hardware_concurrency());
+        for (unsigned int t=1;t<hardwareThreads;t*=2) opt.threadCounts.push_back(t);
+        opt.threadCounts.push_back(hardwareThreads);
+    }
+    vector<const Viewport*> viewports;
+    for (const Viewport &v:benchmarkViewports) {
+        if (opt.viewports.empty() || (find(opt.viewports.begin(),opt.viewports.end(),v.name)!=opt.viewports.end())) viewports.push_back(&v);
+    }
+    LimitSimdLevel(opt.simdLimit);
+    PeriodicityCheckEnabled()=opt.periodicityCheck;
+    InteriorTestEnabled()=opt.interiorTest;
+
+    if (!opt.json) cout<<"label,precision,viewport,res,maxiter,threads,kernel,batch,seconds,pixels_per_sec,iterations,iterations_per_sec,periodic_points,interior_test_points,scaling_efficiency"<<endl;
+
+    //Pools are made once per thread count and reused, so thread start-up is not timed
+    vector<unique_ptr<ThreadPool>> pools;
+    for (unsigned int t:opt.threadCounts) pools.emplace_back(new ThreadPool(t));
+
+    for (const string &precision:opt.precisions) {
+        DispatchPrecision(EnginePrecisions(),precision,[&](auto tag) {
+            typedef typename decltype(tag)::type Float;
+            int digits=std::numeric_limits<Float>::digits;
+            unsigned int batchSize=opt.batchSize?opt.batchSize:((digits<=64)?10240:((digits<=128)?5120:1024));
+            for (const Viewport *view:viewports) {
+                for (int maxIterations:opt.maxIterations) {
+                    double baseThreadSeconds=0;  //Seconds times threads of the first thread count
+                    for (size_t p=0;p<pools.size();p++) {
+                        RunResult best;
+                        for (int r=0;r<opt.repeats;r++) {
+                            RunResult result=RunOnce<Float>(*pools[p],*view,opt.resolution,maxIterations,batchSize);
+                            if ((r==0)||(result.seconds<best.seconds)) best=result;
+                        }
+                        unsigned int threads=pools[p]->Size();
+                        if (p==0) baseThreadSeconds=best.seconds*threads;
+                        PrintRecord(opt,precision,*view,maxIterations,threads,KernelSimdLevel<Float>(),batchSize,best,baseThreadSeconds/(best.seconds*threads));
+                    }
+                }
+            }
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,468 @@
+//Core Mandelbrot set types and kernels shared by the RayLib explorer (main.cpp) and the headless batch renderer (msetBatchRender.cpp).
+//Nothing in this file depends on RayLib, so it can be compiled on machines without a display.
+//Everything is templated on the floating-point type, so each precision gets its own fully specialized kernels from one source.  The explorer compares the
+//three types set below; msetPrecisions.hpp lists every precision the engine is built for and picks among them at runtime.
+#ifndef MSETCORE_HPP
+#define MSETCORE_HPP
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <atomic>
+#include <algorithm>
+
+// Info on standard boost::mp and number class functions:
+// https://www.boost.org/doc/libs/1_76_0/libs/multiprecision/doc/html/boost_multiprecision/ref/backendconc.html
+#define BOOST_MP_DISABLE_DEPRECATE_03_WARNING 1 //Get rid of warning
+#include "boost/multiprecision/cpp_bin_float.hpp"
+#include "multiDouble.hpp"
+
+using namespace std;
+using namespace boost::multiprecision;
+
+//Convenience type definitions for various levels of precision for cpp_bin_float
+typedef number<backends::cpp_bin_float<24, backends::digit_base_2, void, std::int16_t, -126, 127>, et_off>         cpp_bin_float_single;
+typedef number<backends::cpp_bin_float<53, backends::digit_base_2, void, std::int16_t, -1022, 1023>, et_off>       cpp_bin_float_double;
+typedef number<backends::cpp_bin_float<64, backends::digit_base_2, void, std::int16_t, -16382, 16383>, et_off>     cpp_bin_float_double_extended;
+typedef number<backends::cpp_bin_float<113, backends::digit_base_2, void, std::int16_t, -16382, 16383>, et_off>    cpp_bin_float_quad;
+typedef number<backends::cpp_bin_float<237, backends::digit_base_2, void, std::int32_t, -262142, 262143>, et_off>  cpp_bin_float_oct;
+typedef number<backends::cpp_bin_float<500, backends::digit_base_2, void, std::int32_t, -262142, 262143>, et_off>  cpp_bin_float_500;
+typedef number<backends::cpp_bin_float<1000, backends::digit_base_2, void, std::int32_t, -262142, 262143>, et_off> cpp_bin_float_1000;
+
+// OPTION: Set your floating point types below.  Varies cpp_bin_float types have been defined above for convenience.
+// The hardware-double-based double_double (106 bits) and quad_double (212 bits) from multiDouble.hpp can be used too.  They are much faster than
+// cpp_bin_float_quad and cpp_bin_float_oct, and round differently from them, so e.g. second_float=double_double with third_float=cpp_bin_float_quad compares the two.
+typedef double first_float;
+typedef cpp_bin_float_quad second_float;
+typedef cpp_bin_float_oct third_float;
+
+//For pixel-based screen locations in RayLib
+struct int_vector2 {
+    int x;
+    int y;
+};
+
+//Simple complex number type with only the operations that we need for the Mandelbrot set
+template<class Float>
+class MyComplex {
+public:
+    Float real;
+    Float imag;
+    MyComplex(){
+        real=0;
+        imag=0;
+    }
+    MyComplex(Float r, Float i){
+        real=r;
+        imag=i;
+    }
+    //Cast from another precision, e.g. to start a higher-precision type from the first type's coordinate
+    template<class OtherFloat>
+    explicit MyComplex(const MyComplex<OtherFloat> &f) {
+        real=Float(f.real);
+        imag=Float(f.imag);
+    }
+    MyComplex operator+(const MyComplex &rhs) const {
+        MyComplex r;
+        r.real=this->real+rhs.real;
+        r.imag=this->imag+rhs.imag;
+        return r;
+    }
+    MyComplex operator*(const MyComplex &rhs) const {
+        MyComplex r;                                                // (a+bi)*(c+di) = (ac-bd)+(ad+bc)i
+        r.real=(this->real)*rhs.real-(this->imag)*rhs.imag;
+        r.imag=(this->real)*rhs.imag+(this->imag)*rhs.real;
+        return r;
+    }
+    MyComplex Squared() const {
+        MyComplex r;
+        r.real=(this->real)*(this->real)-(this->imag)*(this->imag); // a^2-b^2
+        r.imag=(this->real)*(this->imag)+(this->real)*(this->imag); // 2abi
+        return r;
+    }
+    Float Magnitude() const {
+        Float r;
+        r=(this->real)*(this->real)+(this->imag)*(this->imag);
+        return r;
+    }
+};
+
+template<class Float>
+inline std::ostream& operator<< (std::ostream& os, MyComplex<Float> f) {
+    os<<"( "<<f.real<<" + "<<f.imag<<" i)";
+    return os;
+}
+
+//Start and end indices of a batch of points in a PointStore, for the multithreaded functions that compute the iterations
+struct IndexRange {
+    size_t start;
+    size_t end;
+    size_t Size() const { return end-start; }
+};
+
+//Our fundamental store for relating screen positions to the values they represent and the iterations calculated for each, one per type.  Points are kept
+//as separate arrays (structure of arrays) indexed row-major like the image, so a point's grid position is not stored but follows from its index (GridPos).
+//The kernels stream through the coordinate and orbit arrays, and drawing and the difference screens only touch the compact iterations array.
+//zReal, zImag and orbitIterations keep where each point's orbit got to, so that raising maxIterations resumes from there instead of from z=0, and lowering it
+//only re-thresholds.  Call ResetOrbit() whenever a coordinate changes.
+//Coordinates are generated lazily: a new view only records the center and the offset of every column and row from it (SetView) and marks every point
+//pending (InvalidateCoords).  The batch kernels then generate the coordinates of their own points as they reach them (PrepareCoords), on the worker threads,
+//with one addition per component instead of building each coordinate from scratch.
+//A store can also hold a gathered copy of scattered points of an image, e.g. one level of a progressive render, with gridIndex giving each one's image index.
+template<class Float>
+class PointStore {
+public:
+    int res=0;  //Image width and height in points
+    vector<Float> coordReal, coordImag;
+    vector<int> iterations;
+    vector<Float> zReal, zImag;        //Orbit value after orbitIterations iterations.  Magnitude at least 4 if the point has escaped.
+    vector<int> orbitIterations;       //-1 once the point is known to be interior (periodicity check or interior test)
+    vector<unsigned char> coordPending;  //1 until the point's coordinate has been generated for the current view
+    vector<size_t> gridIndex;          //Empty unless the store is a gathered copy
+    const PointStore<first_float> *castFrom=nullptr;  //If set, coordinates are the first type's cast to this type instead (see the OPTION in main.cpp)
+
+    PointStore(int width=0) { Resize(width); }
+    void Resize(int width) {
+        res=width;
+        Allocate((size_t)width*width);
+        gridIndex.clear();
+    }
+    size_t Size() const { return iterations.size(); }
+    int_vector2 GridPos(size_t i) const {
+        size_t g=gridIndex.empty()?i:gridIndex[i];
+        return {(int)(g%res),(int)(g/res)};
+    }
+    MyComplex<Float> Coord(size_t i) const { return MyComplex<Float>(coordReal[i],coordImag[i]); }
+    void SetCoord(size_t i, const MyComplex<Float> &c) { coordReal[i]=c.real; coordImag[i]=c.imag; }
+    void ResetOrbit(size_t i) { zReal[i]=Float(0); zImag[i]=Float(0); orbitIterations[i]=0; }
+    void ResetOrbits() {
+        std::fill(zReal.begin(),zReal.end(),Float(0));
+        std::fill(zImag.begin(),zImag.end(),Float(0));
+        std::fill(orbitIterations.begin(),orbitIterations.end(),0);
+    }
+
+    //Sets the view coordinates are generated for, with pixel spacing 1/2^zoomDenomPower.  Stored points are left alone.
+    void SetView(const MyComplex<Float> &center, unsigned int zoomDenomPower) {
+        viewCenter=center;
+        offsetReal.resize(res);
+        offsetImag.resize(res);
+        for (int k=0;k<res;k++) {
+            offsetReal[k]=ldexp((Float)(k-res/2),-(int)zoomDenomPower);
+            offsetImag[k]=ldexp((Float)(res/2-k),-(int)zoomDenomPower);
+        }
+    }
+    //Coordinate of a grid position in the current view.  The same value as Grid2Coord gives.
+    MyComplex<Float> CoordAt(int_vector2 gridPos) const {
+        if (castFrom) return MyComplex<Float>(castFrom->CoordAt(gridPos));
+        return MyComplex<Float>(viewCenter.real+offsetReal[gridPos.x],viewCenter.imag+offsetImag[gridPos.y]);
+    }
+    //Marks every point as needing its coordinate generated for the current view, and clears the iterations so the difference screens do not show the old view
+    void InvalidateCoords() {
+        std::fill(coordPending.begin(),coordPending.end(),1);
+        std::fill(iterations.begin(),iterations.end(),0);
+    }
+    void PrepareCoord(size_t i) {
+        if (!coordPending[i]) return;
+        SetCoord(i,CoordAt(GridPos(i)));
+        ResetOrbit(i);
+        coordPending[i]=0;
+    }
+    void PrepareCoords(IndexRange range) {
+        for (size_t i=range.start;i<range.end;i++) PrepareCoord(i);
+    }
+    //Stores a result found without iterating the point's own orbit, e.g. by perturbation or a Mariani-Silver fill.  Its coordinate is still generated, so
+    //that a pan or zoom can tell the result belongs to it and keep it, and any orbit it had is dropped, since it is not the one the result came from.
+    void StoreResult(size_t i, int result) {
+        PrepareCoord(i);
+        ResetOrbit(i);
+        iterations[i]=result;
+    }
+
+    //Copies point i of from, orbit included, to point to of this store
+    void CopyPoint(size_t to, const PointStore &from, size_t i) {
+        coordReal[to]=from.coordReal[i]; coordImag[to]=from.coordImag[i];
+        iterations[to]=from.iterations[i];
+        zReal[to]=from.zReal[i]; zImag[to]=from.zImag[i];
+        orbitIterations[to]=from.orbitIterations[i];
+        coordPending[to]=from.coordPending[i];
+    }
+    //Makes this store a copy of the given points of image, in that order.  Prepare their coordinates first, since the copy has no view to generate them from.
+    void Gather(const PointStore &image, const vector<size_t> &indices) {
+        res=image.res;
+        Allocate(indices.size());
+        gridIndex=indices;
+        for (size_t j=0;j<indices.size();j++) CopyPoint(j,image,indices[j]);
+    }
+    //Copies the points back to where Gather took them from
+    void Scatter(PointStore &image) const {
+        for (size_t j=0;j<gridIndex.size();j++) image.CopyPoint(gridIndex[j],*this,j);
+    }
+    size_t MemoryBytes() const {
+        return (coordReal.capacity()+coordImag.capacity()+zReal.capacity()+zImag.capacity()+offsetReal.capacity()+offsetImag.capacity())*sizeof(Float)
+               +(iterations.capacity()+orbitIterations.capacity())*sizeof(int)+coordPending.capacity()+gridIndex.capacity()*sizeof(size_t);
+    }
+
+private:
+    void Allocate(size_t n) {
+        coordReal.assign(n,Float(0)); coordImag.assign(n,Float(0));
+        iterations.assign(n,0);
+        zReal.assign(n,Float(0)); zImag.assign(n,Float(0));
+        orbitIterations.assign(n,0);
+        coordPending.assign(n,0);
+    }
+
+    MyComplex<Float> viewCenter;
+    vector<Float> offsetReal, offsetImag;  //Offset of each column and row from viewCenter.  Exact, since they are small multiples of a power of two.
+};
+
+//Names for the three types the explorer compares
+typedef MyComplex<first_float> MyComplex_first_float;
+typedef MyComplex<second_float> MyComplex_second_float;
+typedef MyComplex<third_float> MyComplex_third_float;
+typedef PointStore<first_float> PointStore_first_float;
+typedef PointStore<second_float> PointStore_second_float;
+typedef PointStore<third_float> PointStore_third_float;
+
+//Counts the iterations a kernel does on a range of points, for tracing and scheduling: construct it before the kernel runs and call Done() after.  The
+//kernels resume orbits, so those are the growth of each point's orbitIterations.  Perturbation keeps no orbits, so only its escaped points count, with the
+//iteration they escaped at.  Points found interior lose their orbit count and are not counted either, so the count is a lower bound.
+class IterationCounter {
+public:
+    template<class StoreType>
+    IterationCounter(const StoreType &points, IndexRange range) : start(range.start), orbitBefore(range.Size()) {
+        for (size_t i=range.start;i<range.end;i++) orbitBefore[i-start]=points.coordPending[i]?0:std::max(points.orbitIterations[i],0);
+    }
+    template<class StoreType>
+    unsigned long long Done(const StoreType &points, IndexRange done) const {
+        unsigned long long total=0;
+        for (size_t i=done.start;i<done.end;i++) {
+            int orbit=points.orbitIterations[i];
+            if (orbit>0) total+=std::max(orbit-orbitBefore[i-start],0);
+            else if ((orbit==0) && (points.iterations[i]>0)) total+=points.iterations[i];
+        }
+        return total;
+    }
+private:
+    size_t start;
+    vector<int> orbitBefore;
+};
+
+//Takes a screen coordinate and transforms it to a complex type of our selected precision.  halfRes is half the image width in pixels (512 for the 1024x1024 RayLib screen)
+//The pixel spacing 1/2^zoomDenomPower is applied with ldexp, which is exact and has no limit on zoomDenomPower other than the type's own exponent range.
+template<class Float>
+inline MyComplex<Float> Grid2Coord(int_vector2 gc, const MyComplex<Float> &coordCenter, unsigned int zoomDenomPower, int halfRes=512) {
+    MyComplex<Float> p;
+    p.real=coordCenter.real+ldexp((Float)(gc.x-halfRes),-(int)zoomDenomPower);
+    p.imag=coordCenter.imag+ldexp((Float)(halfRes-gc.y),-(int)zoomDenomPower);
+    return p;
+}
+
+//Inverse function to the above.  Transforms complex type to screen coordinate.  Only used for plotting point trajectories in screen 8 view
+template<class Float>
+inline int_vector2 Coord2Grid(const MyComplex<Float> &c){
+    Float xf=c.real*Float(256);
+    Float yf=c.imag*Float(256);
+    int_vector2 gc;
+    gc.x=int(xf)+512;
+    gc.y=512-int(yf);
+    return gc;
+}
+
+//Lets the UI thread abandon work for a view that is no longer wanted.  Work is queued with the generation current at the time; whenever the view changes
+//the UI thread increments *currentGeneration, and the kernels below notice the mismatch and return without storing anything.
+//A default-constructed token is never cancelled.
+struct CancelToken {
+    const std::atomic<unsigned int> *currentGeneration=nullptr;
+    unsigned int generation=0;
+    bool Cancelled() const {
+        return (currentGeneration!=nullptr) && (currentGeneration->load(std::memory_order_relaxed)!=generation);
+    }
+};
+
+//How many iterations a kernel runs between checks of its CancelToken.  Must be a power of two minus one.  1023 iterations of the slowest type take well under a millisecond.
+const int cancelCheckMask=1023;
+
+//Periodicity checking.  An orbit that comes back to within PeriodicityTolerance of a value it had earlier is caught in an attracting cycle and will never
+//escape, so the point is stored as interior (0) straight away instead of iterating to maxIterations.  This is Brent's method: the orbit value is saved at
+//iterations 1, 2, 4, 8, ... and every iteration is compared against the last saved value, which finds a cycle of any period.
+//The tolerance is a small multiple of each type's own epsilon, but never more than a tiny fraction of the pixel spacing: at deep zooms, escaping points near
+//a minibrot shadow its cycle for thousands of iterations at about the pixel scale, and must not be mistaken for interior points.
+//Switchable at runtime so that renders can be compared with and without it.  Kernels read the switch and tolerance once per batch (KernelSettings).
+inline std::atomic<bool>& PeriodicityCheckEnabled() {
+    static std::atomic<bool> enabled(true);
+    return enabled;
+}
+
+//Points found to be periodic since the last reset, per precision.  Types that share a precision share the count.
+template<class Float>
+inline std::atomic<unsigned long long>& PeriodicPoints() {
+    static std::atomic<unsigned long long> count(0);
+    return count;
+}
+
+inline std::atomic<unsigned int>& PeriodicityZoomDenomPower() {
+    static std::atomic<unsigned int> zoomDenomPower(0);
+    return zoomDenomPower;
+}
+
+//Call whenever the zoom changes.  Applies to every precision.
+inline void SetPeriodicityTolerance(unsigned int zoomDenomPower) {
+    PeriodicityZoomDenomPower()=zoomDenomPower;
+}
+
+template<class Float>
+inline Float PeriodicityTolerance() {
+    int pixelFraction=-(int)PeriodicityZoomDenomPower().load(std::memory_order_relaxed)-20;  //1/2^20 of the pixel spacing
+    return std::min(Float(std::numeric_limits<Float>::epsilon()*1024),ldexp(Float(1),pixelFraction));
+}
+
+//Closed-form interior tests, applied by the batch kernels before iterating a point.  Points in the main cardioid, the period-2 bulb or a few more of the largest
+//bulbs never escape, so they are stored as interior (0) without iterating.  The cardioid and period-2 bulb tests are exact.  The other bulbs are not discs,
+//so each is covered by a disc that lies inside it with a 1% margin, measured against the bulb's boundary found numerically from its multiplier.
+//Each test is evaluated in the type's own arithmetic.  Switchable at runtime like the periodicity check.
+inline std::atomic<bool>& InteriorTestEnabled() {
+    static std::atomic<bool> enabled(true);
+    return enabled;
+}
+
+//Points skipped by the interior test since the last reset, per precision
+template<class Float>
+inline std::atomic<unsigned long long>& InteriorTestPoints() {
+    static std::atomic<unsigned long long> count(0);
+    return count;
+}
+
+//Discs inside bulbs, upper half-plane only.  Centers are close to, but not exactly at, the bulbs' nuclei, to get the largest disc.
+struct InteriorDisc { double centerReal, centerImag, radiusSquared; };
+const InteriorDisc knownInteriorDiscs[]={
+    {-0.1248, 0.7440, 0.0087},   //Period 3, the 1/3 bulb on the main cardioid
+    {-1.3090, 0.0,    0.0034},   //Period 4, on the period-2 bulb
+    { 0.2811, 0.5310, 0.00188},  //Period 4, the 1/4 bulb
+    {-0.5045, 0.5630, 0.00146},  //Period 5, the 2/5 bulb
+    { 0.3793, 0.3360, 0.00054}   //Period 5, the 1/5 bulb
+};
+
+template<class Float>
+inline bool InKnownComponent(const MyComplex<Float> &c) {
+    Float x=c.real;
+    Float y=abs(c.imag);  //The set is symmetric about the real axis
+    Float y2=y*y;
+    Float xq=x-Float(0.25);
+    Float q=xq*xq+y2;
+    if (q*(q+xq)<y2*Float(0.25)) return true;  //Main cardioid
+    Float xp=x+Float(1);
+    if (xp*xp+y2<Float(0.0625)) return true;  //Period-2 bulb
+    for (const InteriorDisc &d:knownInteriorDiscs) {
+        Float dx=x-Float(d.centerReal);
+        Float dy=y-Float(d.centerImag);
+        if (dx*dx+dy*dy<Float(d.radiusSquared)) return true;
+    }
+    return false;
+}
+
+//Runtime switches and the periodicity tolerance, read once per batch rather than once per point
+template<class Float>
+struct KernelSettings {
+    bool checkPeriod=PeriodicityCheckEnabled().load(std::memory_order_relaxed);
+    bool checkInterior=InteriorTestEnabled().load(std::memory_order_relaxed);
+    Float periodTolerance=PeriodicityTolerance<Float>();
+};
+
+//Core function to calculate iteration value for just one point, continuing its orbit from the stored z.  A point that escaped at or beyond maxIterations is not
+//iterated again, only re-thresholded.  Returns false, leaving its iterations untouched, if cancelled part way through.
+template<class Float>
+inline bool msetPoint(PointStore<Float> &points, size_t i, int maxIterations, const CancelToken &cancel, const KernelSettings<Float> &settings) {
+    if (points.orbitIterations[i]<0) {  //Known interior
+        points.iterations[i]=0;
+        return true;
+    }
+    MyComplex<Float> c(points.zReal[i],points.zImag[i]);
+    MyComplex<Float> coord=points.Coord(i);
+    Float maxMagnitude=Float(4.0);
+    int iterationCounter=points.orbitIterations[i];
+    int startIteration=iterationCounter;
+    MyComplex<Float> saved=c;  //Brent's method: orbit value at the last power-of-two iteration, restarted from wherever the orbit resumes
+    unsigned int saveAt=(startIteration>0)?2*(unsigned int)startIteration:1;
+
+    while ( (c.Magnitude()<maxMagnitude) && (iterationCounter<maxIterations) ) {
+        if (settings.checkPeriod && (iterationCounter>startIteration)) {
+            if ( (abs(c.real-saved.real)<settings.periodTolerance) && (abs(c.imag-saved.imag)<settings.periodTolerance) ) {
+                PeriodicPoints<Float>()++;
+                points.iterations[i]=0;
+                points.orbitIterations[i]=-1;
+                return true;
+            }
+            if ((unsigned int)iterationCounter==saveAt) {
+                saved=c;
+                saveAt*=2;
+            }
+        }
+        c=c.Squared()+coord;
+        iterationCounter++;
+        if ( ((iterationCounter&cancelCheckMask)==0) && cancel.Cancelled() ) {
+            points.zReal[i]=c.real;  //Still a valid place to resume from
+            points.zImag[i]=c.imag;
+            points.orbitIterations[i]=iterationCounter;
+            return false;
+        }
+    }
+    points.zReal[i]=c.real;
+    points.zImag[i]=c.imag;
+    points.orbitIterations[i]=iterationCounter;
+
+    if (iterationCounter<maxIterations) {  //We have bounded out
+            points.iterations[i]=iterationCounter;
+            return true;
+    }
+    //Otherwise, we've hit max iter, return zero
+    points.iterations[i]=0;
+    return true;
+}
+
+template<class Float>
+inline bool msetPoint(PointStore<Float> &points, size_t i, int maxIterations, const CancelToken &cancel=CancelToken()) {
+    return msetPoint(points,i,maxIterations,cancel,KernelSettings<Float>());
+}
+
+//Wraps the above function to work with ranges of point indices, generating pending coordinates and applying the interior test first.  The same range is returned because work is not necessarily finished in the same order that
+//we submitted it, so we need to know what batch of pixels was just completed.  We only draw newly-computed pixels to their respective screen textures, rather than plotting 3x1024x1024 pixels every frame.
+//If cancelled, end is pulled back to the first point that was not finished.
+template<class Float>
+inline IndexRange msetBatch(PointStore<Float> &points, IndexRange range, int maxIterations, CancelToken cancel=CancelToken()) {
+    points.PrepareCoords(range);
+    KernelSettings<Float> settings;
+    unsigned long long interiorPoints=0;
+    for (size_t i=range.start; i<range.end; i++) {
+        if (settings.checkInterior && (points.orbitIterations[i]==0) && InKnownComponent(points.Coord(i))) {
+            points.iterations[i]=0;
+            points.orbitIterations[i]=-1;
+            interiorPoints++;
+            continue;
+        }
+        if ( cancel.Cancelled() || !msetPoint(points,i,maxIterations,cancel,settings) ) {
+            range.end=i;
+            break;
+        }
+    }
+    InteriorTestPoints<Float>()+=interiorPoints;
+return range;
+}
+
+//Returns a list of points for plotting the trajectory of a point in screen 8 display mode.  Shows how different precision give rise to different trajectories,
+//which in turn gives rise to different iteration values for different precisions
+template<class Float>
+inline vector<int_vector2> msetPath(const MyComplex<Float> &c, int maxIterations) {
+    MyComplex<Float> z;
+    vector<int_vector2> points;
+    Float maxMagnitude=Float(4.0);
+    int iterationCounter=0;
+
+    while ( (z.Magnitude()<maxMagnitude) && (iterationCounter<maxIterations) ) {
+        z=z.Squared()+c;
+        iterationCounter++;
+        points.push_back(Coord2Grid(z));
+    }
+return points;
+}
+
+#endif // MSETCORE_HPP
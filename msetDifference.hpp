@@ -0,0 +1,222 @@
+//The explorer's three difference screens (type 2 - type 1, type 3 - type 1 and type 3 - type 2) and their statistics, kept up to date as points finish
+//instead of being recomputed from all 1M pixels whenever a difference screen is chosen.  Switching to one is then instant, and computing need not stop.
+//
+//The worker that finishes a tile passes the tile's new iteration counts to UpdateTile.  Only if any of them changed are the two differences involving
+//that type recomputed, four points at a time, and only the pixels whose difference changed are recolored.  The counts are copied into the maps' own
+//arrays first, since the other types' stores may be mid-batch at that tile.  Each tile has a lock, so updates of the same tile by different types'
+//workers, and the UI thread reading the tile for upload or statistics, take turns.  Each tile keeps its own count of differing pixels and minimum and
+//maximum difference, which Total() adds up.
+#ifndef MSETDIFFERENCE_HPP
+#define MSETDIFFERENCE_HPP
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include "msetCore.hpp"
+#include "msetThreadPool.hpp"
+#include "msetTiles.hpp"
+#include "msetFramebuffer.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+struct DifferenceStats {
+    unsigned int count=0;  //Pixels whose iteration counts differ
+    int min=0, max=0;
+};
+
+template<class Pixel>
+class DifferenceMaps {
+public:
+    static const int numTypes=3, numPairs=3;
+
+    //palette colors a difference, as for colorizePixelDiff
+    DifferenceMaps(const TileGrid &grid, const PaletteTable<Pixel> &palette) : grid(grid), palette(palette), locks(new std::mutex[grid.Count()]),
+        changedTiles(new std::atomic<unsigned int>[grid.Count()]) {
+        size_t size=(size_t)grid.res*grid.res;
+        for (int t=0;t<numTypes;t++) counts[t].assign(size,0);
+        for (int p=0;p<numPairs;p++) {
+            differences[p].assign(size,0);
+            images.emplace_back(grid,palette(0));
+            tileStats[p].resize(grid.Count());
+            statsStale[p].assign(grid.Count(),0);
+        }
+        for (int tile=0;tile<grid.Count();tile++) changedTiles[tile]=0;
+    }
+
+    //Pair 0 is type 2 - type 1, pair 1 type 3 - type 1 and pair 2 type 3 - type 2
+    static int HigherType(int pair) { return (pair==0)?2:3; }
+    static int LowerType(int pair) { return (pair==2)?2:1; }
+
+    //The colored map of a pair.  Its tiles may be written by the workers at any time: upload it with Flush.
+    Framebuffer<Pixel>& Image(int pair) { return images[pair]; }
+
+    //A tile of type 1-3 has finished, with the type's iteration counts in iterations, indexed as in the image.  Called by the worker that finished it.
+    void UpdateTile(int type, const int *iterations, int tile) {
+        std::lock_guard<std::mutex> lock(locks[tile]);
+        unsigned int changed=0;
+        for (int r=0;r<grid.tileSize;r++) changed|=UpdateSegment(type-1,iterations,grid.Row(tile,r));
+        for (int p=0;p<numPairs;p++) {
+            if (!(changed&(1u<<p))) continue;
+            tileStats[p][tile]=ComputeTileStats(p,tile);
+            statsStale[p][tile]=0;
+        }
+        if (changed) changedTiles[tile].fetch_or(changed);
+    }
+
+    //The points of range of type 1-3 have finished, e.g. ranges from Mariani-Silver or progressive rendering, which can be single pixels.  The statistics
+    //of the tiles touched are recomputed when next asked for rather than after every range.
+    void UpdateRange(int type, const int *iterations, IndexRange range) {
+        size_t i=range.start;
+        while (i<range.end) {
+            int x=(int)(i%grid.res), y=(int)(i/grid.res);
+            int end=std::min((x/grid.tileSize+1)*grid.tileSize,x+(int)std::min(range.end-i,(size_t)grid.res));  //To the end of the range or the tile's row
+            int tile=(y/grid.tileSize)*grid.TilesPerRow()+x/grid.tileSize;
+            std::lock_guard<std::mutex> lock(locks[tile]);
+            unsigned int changed=UpdateSegment(type-1,iterations,{i,i+(end-x)});
+            for (int p=0;p<numPairs;p++) if (changed&(1u<<p)) statsStale[p][tile]=1;
+            if (changed) changedTiles[tile].fetch_or(changed);
+            i+=end-x;
+        }
+    }
+
+    //Brings every pixel up to date with the three types' counts, e.g. after their stores were shifted.  Only while nothing else is updating.  Given a pool,
+    //which must be idle and not paused, each row of tiles is a task on it and this returns once they are done; otherwise it all runs on the calling thread.
+    void UpdateAll(const int *iterations1, const int *iterations2, const int *iterations3, ThreadPool *pool=nullptr) {
+        const int *iterations[numTypes]={iterations1,iterations2,iterations3};
+        auto updateRow=[this,iterations](int tileRow) {
+            for (int t=0;t<numTypes;t++) {
+                for (int c=0;c<grid.TilesPerRow();c++) UpdateTile(t+1,iterations[t],tileRow*grid.TilesPerRow()+c);
+            }
+        };
+        for (int tileRow=0;tileRow<grid.TilesPerRow();tileRow++) {
+            if (pool) pool->Submit([updateRow,tileRow]() { updateRow(tileRow); });
+            else updateRow(tileRow);
+        }
+        if (pool) pool->WaitIdle();
+    }
+
+    DifferenceStats Total(int pair) {
+        DifferenceStats total;
+        for (int tile=0;tile<grid.Count();tile++) {
+            std::lock_guard<std::mutex> lock(locks[tile]);
+            if (statsStale[pair][tile]) {
+                tileStats[pair][tile]=ComputeTileStats(pair,tile);
+                statsStale[pair][tile]=0;
+            }
+            const DifferenceStats &s=tileStats[pair][tile];
+            total.count+=s.count;
+            total.min=std::min(total.min,s.min);
+            total.max=std::max(total.max,s.max);
+        }
+        return total;
+    }
+
+    //Uploads the tiles of a pair's map that changed since its last Flush, as Framebuffer::Flush.  UI thread only.
+    template<class Upload>
+    void Flush(int pair, Upload &&upload) {
+        for (int tile=0;tile<grid.Count();tile++) {
+            if (changedTiles[tile].fetch_and(~(1u<<pair))&(1u<<pair)) images[pair].MarkTile(tile);
+        }
+        images[pair].Flush(upload,[this](int tile) { return std::unique_lock<std::mutex>(locks[tile]); });
+    }
+
+private:
+    //Takes the counts of type t over range, which lies in one row of one tile whose lock is held.  Returns the pairs whose differences changed, as bits.
+    unsigned int UpdateSegment(int t, const int *iterations, IndexRange range) {
+        size_t n=range.Size();
+        const int *source=iterations+range.start;
+        int *count=&counts[t][range.start];
+        if (std::equal(source,source+n,count)) return 0;
+        std::copy_n(source,n,count);
+
+        unsigned int changed=0;
+        for (int p=0;p<numPairs;p++) {
+            if ((HigherType(p)-1!=t) && (LowerType(p)-1!=t)) continue;
+            if (Subtract(&counts[HigherType(p)-1][range.start],&counts[LowerType(p)-1][range.start],&differences[p][range.start],&images[p][range.start],n)) {
+                changed|=1u<<p;
+            }
+        }
+        return changed;
+    }
+
+    //difference=higher-lower for n points, recoloring only the pixels whose difference changed.  Returns whether any did.  Four points at a time with SSE2,
+    //which every x86-64 CPU has.
+    bool Subtract(const int *higher, const int *lower, int *difference, Pixel *pixel, size_t n) const {
+        bool any=false;
+        size_t i=0;
+#ifdef __SSE2__
+        for (;i+4<=n;i+=4) {
+            __m128i d=_mm_sub_epi32(_mm_loadu_si128((const __m128i*)(higher+i)),_mm_loadu_si128((const __m128i*)(lower+i)));
+            int same=_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(d,_mm_loadu_si128((const __m128i*)(difference+i)))));
+            if (same==0xF) continue;
+            _mm_storeu_si128((__m128i*)(difference+i),d);
+            for (int l=0;l<4;l++) if (!(same&(1<<l))) pixel[i+l]=palette(difference[i+l]);
+            any=true;
+        }
+#endif
+        for (;i<n;i++) {
+            int d=higher[i]-lower[i];
+            if (d==difference[i]) continue;
+            difference[i]=d;
+            pixel[i]=palette(d);
+            any=true;
+        }
+        return any;
+    }
+
+    //Adds n differences to stats
+    static void AddStats(const int *difference, size_t n, DifferenceStats &stats) {
+        size_t i=0;
+#ifdef __SSE2__
+        __m128i zero=_mm_setzero_si128(), zeros=zero, low=zero, high=zero;
+        for (;i+4<=n;i+=4) {
+            __m128i d=_mm_loadu_si128((const __m128i*)(difference+i));
+            zeros=_mm_sub_epi32(zeros,_mm_cmpeq_epi32(d,zero));  //Equal lanes are -1
+            __m128i below=_mm_cmplt_epi32(d,low), above=_mm_cmpgt_epi32(d,high);  //SSE2 has no integer min and max
+            low=_mm_or_si128(_mm_and_si128(below,d),_mm_andnot_si128(below,low));
+            high=_mm_or_si128(_mm_and_si128(above,d),_mm_andnot_si128(above,high));
+        }
+        int laneZeros[4], laneLow[4], laneHigh[4];
+        _mm_storeu_si128((__m128i*)laneZeros,zeros);
+        _mm_storeu_si128((__m128i*)laneLow,low);
+        _mm_storeu_si128((__m128i*)laneHigh,high);
+        stats.count+=(unsigned int)i;
+        for (int l=0;l<4;l++) {
+            stats.count-=laneZeros[l];
+            stats.min=std::min(stats.min,laneLow[l]);
+            stats.max=std::max(stats.max,laneHigh[l]);
+        }
+#endif
+        for (;i<n;i++) {
+            stats.count+=(difference[i]!=0);
+            stats.min=std::min(stats.min,difference[i]);
+            stats.max=std::max(stats.max,difference[i]);
+        }
+    }
+
+    //With the tile's lock held
+    DifferenceStats ComputeTileStats(int pair, int tile) const {
+        DifferenceStats stats;
+        for (int r=0;r<grid.tileSize;r++) {
+            IndexRange row=grid.Row(tile,r);
+            AddStats(&differences[pair][row.start],row.Size(),stats);
+        }
+        return stats;
+    }
+
+    TileGrid grid;
+    const PaletteTable<Pixel> &palette;
+    std::vector<int> counts[numTypes];         //Each type's counts as of its last update
+    std::vector<int> differences[numPairs];
+    std::vector<Framebuffer<Pixel>> images;
+    std::unique_ptr<std::mutex[]> locks;       //One per tile, guarding all of the above for its pixels, and the two below
+    std::vector<DifferenceStats> tileStats[numPairs];
+    std::vector<char> statsStale[numPairs];
+    std::unique_ptr<std::atomic<unsigned int>[]> changedTiles;  //Per tile, the pairs changed since their last Flush, as bits
+};
+
+#endif // MSETDIFFERENCE_HPP
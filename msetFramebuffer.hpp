@@ -0,0 +1,171 @@
+//CPU-side images of the explorer's screens.  Drawing every new pixel to a RenderTexture with DrawPixel costs the UI thread one immediate-mode draw call
+//per pixel, millions per view.  Instead each screen has a Framebuffer in main memory, row-major like the PointStores, that pixels are colored into by table
+//lookup (PaletteTable): by the workers as they finish tiles, so coloring runs in parallel with everything else, or by the UI thread for ranges it is handed.
+//The UI thread marks what it has been told is finished and Flush() sends just those regions to the screen's texture, one upload per region.
+//
+//Workers only write the pixels of tiles they are computing, and the UI thread only reads tiles once they have been pushed as finished, so neither needs
+//a lock.  Operations on the whole image (Fill, Shift, Magnify) are for when no worker is running, i.e. after stopAllBatches.
+#ifndef MSETFRAMEBUFFER_HPP
+#define MSETFRAMEBUFFER_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "msetCore.hpp"
+#include "msetTiles.hpp"
+
+//The colors of a palette of iteration counts that repeats every period counts on each side of 0, so coloring a pixel is a table lookup instead of a
+//call.  colorOf(i) must equal colorOf(i+period) for every i>0 and colorOf(i-period) for every i<0.
+template<class Pixel>
+class PaletteTable {
+public:
+    template<class ColorOf>
+    PaletteTable(ColorOf colorOf, int period) : period((unsigned int)period), zero(colorOf(0)), positive(period), negative(period) {
+        for (int k=0;k<period;k++) {
+            positive[k]=colorOf(period+k);
+            negative[k]=colorOf(-(period+k));
+        }
+    }
+
+    Pixel operator()(int i) const {
+        if (i>0) return positive[(unsigned int)i%period];
+        if (i<0) return negative[(0u-(unsigned int)i)%period];
+        return zero;
+    }
+
+private:
+    unsigned int period;
+    Pixel zero;
+    std::vector<Pixel> positive, negative;
+};
+
+template<class Pixel>
+class Framebuffer {
+public:
+    //An image the size of grid, whose tiles are the regions Flush() uploads
+    Framebuffer(const TileGrid &grid, Pixel fill) : grid(grid), pixels((size_t)grid.res*grid.res,fill), dirtyTiles(grid.Count(),0) {}
+
+    int Width() const { return grid.res; }
+    int Height() const { return grid.res; }
+    Pixel* Data() { return pixels.data(); }
+    //Pixel at an image index, as for PointStore
+    Pixel& operator[](size_t i) { return pixels[i]; }
+
+    void Fill(Pixel fill) { std::fill(pixels.begin(),pixels.end(),fill); }
+
+    //Clipped to the image
+    void FillRect(int x, int y, int w, int h, Pixel fill) {
+        int x0=std::max(x,0), x1=std::min(x+w,grid.res), y1=std::min(y+h,grid.res);
+        if (x0>=x1) return;
+        for (int row=std::max(y,0);row<y1;row++) std::fill_n(&pixels[(size_t)row*grid.res+x0],x1-x0,fill);
+    }
+
+    //As ShiftPoints: the pixel now at (x,y) takes the old (x+dx,y+dy), and those with no old pixel are filled
+    void Shift(int dx, int dy, Pixel fill) {
+        int res=grid.res;
+        if ((std::abs(dx)>=res) || (std::abs(dy)>=res)) {
+            Fill(fill);
+            return;
+        }
+        int width=res-std::abs(dx);
+        for (int k=0;k<res;k++) {
+            int y=(dy>0)?k:res-1-k;  //Walk away from the sources, so none is overwritten before it is read
+            Pixel *row=&pixels[(size_t)y*res];
+            int sy=y+dy;
+            if ((sy<0) || (sy>=res)) {
+                std::fill(row,row+res,fill);
+                continue;
+            }
+            Pixel *line=temp(width);
+            std::copy_n(&pixels[(size_t)sy*res+std::max(dx,0)],width,line);
+            std::copy_n(line,width,row+std::max(-dx,0));
+            std::fill(row+((dx>0)?width:0),row+((dx>0)?res:-dx),fill);
+        }
+    }
+
+    //After ZoomPoints: zooming in by 2^step, the middle of the old image magnified about the center, as a preview of the new one until its points are
+    //computed.  Zooming out (step<0) the whole image is filled, for the points carried over to be painted on.
+    void Magnify(int step, Pixel fill) {
+        if (step<=0) {
+            Fill(fill);
+            return;
+        }
+        int res=grid.res, half=res/2, factor=1<<step;
+        std::vector<Pixel> old(pixels);
+        auto source=[&](int p) { int o=p-half; return half+((o>=0)?o/factor:-((-o+factor-1)/factor)); };  //Rounds down
+        for (int y=0;y<res;y++) {
+            const Pixel *from=&old[(size_t)source(y)*res];
+            Pixel *row=&pixels[(size_t)y*res];
+            for (int x=0;x<res;x++) row[x]=from[source(x)];
+        }
+    }
+
+    //Regions to upload at the next Flush().  Only the UI thread marks and flushes.
+    void MarkTile(int tile) { dirtyTiles[tile]=1; }
+    //Rows y0 to y1-1, e.g. those of ranges the UI thread painted
+    void MarkRows(int y0, int y1) {
+        dirtyTop=std::min(dirtyTop,std::max(y0,0));
+        dirtyBottom=std::max(dirtyBottom,std::min(y1,grid.res));
+    }
+    void MarkAll() { MarkRows(0,grid.res); }
+
+    //Calls upload(data, x, y, width, height) with each region marked since the last Flush, data holding its pixels row after row, and clears the marks.
+    //A band of whole rows is uploaded straight from the image.  Marked tiles are uploaded a row of tiles at a time, as runs of adjacent tiles copied
+    //together, so a frame that finished many tiles makes a few large uploads rather than one per tile.
+    template<class Upload>
+    void Flush(Upload &&upload) { Flush(upload,[](int) { return 0; }); }
+
+    //As above, for an image whose tiles other threads may be writing: each marked tile is copied while holding guard(tile), e.g. a lock on it
+    template<class Upload, class Guard>
+    void Flush(Upload &&upload, Guard &&guard) {
+        int res=grid.res, size=grid.tileSize, perRow=grid.TilesPerRow();
+        if (dirtyTop<dirtyBottom) upload((const Pixel*)&pixels[(size_t)dirtyTop*res],0,dirtyTop,res,dirtyBottom-dirtyTop);
+        for (int tileRow=0;tileRow<perRow;tileRow++) {
+            bool inBand=(tileRow*size>=dirtyTop) && ((tileRow+1)*size<=dirtyBottom);
+            for (int c=0;c<perRow;) {
+                if (!dirtyTiles[tileRow*perRow+c] || inBand) { c++; continue; }
+                int c1=c;
+                while ((c1<perRow) && dirtyTiles[tileRow*perRow+c1]) c1++;
+                int width=(c1-c)*size;
+                Pixel *region=temp(width*size);
+                for (int t=c;t<c1;t++) {
+                    auto held=guard(tileRow*perRow+t);
+                    (void)held;
+                    for (int r=0;r<size;r++) std::copy_n(&pixels[(size_t)(tileRow*size+r)*res+t*size],size,region+(size_t)r*width+(t-c)*size);
+                }
+                upload((const Pixel*)region,c*size,tileRow*size,width,size);
+                c=c1;
+            }
+        }
+        std::fill(dirtyTiles.begin(),dirtyTiles.end(),0);
+        dirtyTop=noRows;
+        dirtyBottom=0;
+    }
+
+private:
+    Pixel* temp(size_t n) {
+        if (staging.size()<n) staging.resize(n);
+        return staging.data();
+    }
+
+    TileGrid grid;
+    std::vector<Pixel> pixels;
+    std::vector<Pixel> staging;  //For Shift and Flush
+    std::vector<char> dirtyTiles;
+    static const int noRows=1<<30;
+    int dirtyTop=noRows, dirtyBottom=0;  //Band of marked rows, empty if dirtyTop>=dirtyBottom
+};
+
+//Colors the points of range, indexed as in the framebuffer, by their iteration counts
+template<class Pixel, class StoreType>
+inline void PaintRange(Framebuffer<Pixel> &image, const StoreType &points, IndexRange range, const PaletteTable<Pixel> &palette) {
+    for (size_t i=range.start;i<range.end;i++) image[i]=palette(points.iterations[i]);
+}
+
+//Colors every point of a tile.  Called by the workers on the tiles they finish.
+template<class Pixel, class StoreType>
+inline void PaintTile(Framebuffer<Pixel> &image, const StoreType &points, const TileGrid &grid, int tile, const PaletteTable<Pixel> &palette) {
+    for (int r=0;r<grid.tileSize;r++) PaintRange(image,points,grid.Row(tile,r),palette);
+}
+
+#endif // MSETFRAMEBUFFER_HPP
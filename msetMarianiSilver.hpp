@@ -0,0 +1,224 @@
+//Mariani-Silver rectangle subdivision.  Instead of iterating every pixel, a rectangle's border is iterated first; if every border pixel has the same iteration
+//count the inside is filled with it, since the set is connected and a region bounded by one iteration band contains only that band (barring features
+//smaller than a pixel that slip between border pixels, which is why this is opt-in).  Otherwise the rectangle is split in two along its longer side, the
+//dividing line is iterated, and each half goes back to the thread pool as a new task with its border already known.
+//
+//Every pixel is computed (or filled) and reported exactly once, as row segments pushed to the same ResultQueue the batch kernels use, so the RayLib
+//explorer draws and counts them like any other batch.  A dividing column is computed as one batch, gathered into a scratch store, but is not reported on its
+//own, which would be one range per pixel.  Instead the rectangle to its left reports it as the last pixel of each of its inside rows.  The image's outer
+//columns are reported the same way.  In verify mode, filled pixels are also iterated directly and differences are counted as fill mismatches, without
+//changing what is stored.
+//
+//After a pan or zoom only the new pixels need computing.  They are split into rectangles, e.g. a band of rows and a band of columns after a pan, and each one is
+//rendered as an image of its own, starting from its border.  Pixels scattered too finely for that, as after zooming in, get a render of the whole image.
+#ifndef MSETMARIANISILVER_HPP
+#define MSETMARIANISILVER_HPP
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include "msetCore.hpp"
+#include "msetThreadPool.hpp"
+
+//Rectangles whose inside is smaller than this in either direction are iterated in full rather than split further
+const int marianiSilverMinInside=4;
+
+//More rectangles of new pixels than this and the whole image is rendered instead
+const size_t marianiSilverMaxRects=16;
+
+//Pixels x0..x1 by y0..y1
+struct PixelRect {
+    int x0, y0, x1, y1;
+};
+
+//The points of ranges of a res x res image as rectangles, each made of the same span of consecutive rows, or just the whole image if they take more than
+//marianiSilverMaxRects.  ranges must be sorted and not overlap, as ShiftPoints and ZoomPoints return them.
+inline std::vector<PixelRect> MarianiSilverRects(const std::vector<IndexRange> &ranges, int res) {
+    std::vector<PixelRect> rects;
+    std::vector<size_t> above, current;  //Rectangles reaching the previous row, and this one
+    int row=-2;
+    for (const IndexRange &range:ranges) {
+        size_t i=range.start;
+        while (i<range.end) {
+            int y=(int)(i/res), x0=(int)(i%res);
+            int x1=(int)(std::min((size_t)(y+1)*res,range.end)-1-(size_t)y*res);
+            i=(size_t)y*res+x1+1;
+            if (y!=row) {
+                if (y==row+1) above.swap(current);
+                else above.clear();
+                current.clear();
+                row=y;
+            }
+            auto extend=std::find_if(above.begin(),above.end(),[&](size_t r) { return (rects[r].x0==x0) && (rects[r].x1==x1); });
+            if (extend!=above.end()) {
+                rects[*extend].y1=y;
+                current.push_back(*extend);
+                continue;
+            }
+            if (rects.size()==marianiSilverMaxRects) return {{0,0,res-1,res-1}};
+            rects.push_back({x0,y,x1,y});
+            current.push_back(rects.size()-1);
+        }
+    }
+    return rects;
+}
+
+struct MarianiSilverStats {
+    std::atomic<unsigned long long> filledPoints{0};
+    std::atomic<unsigned long long> fillMismatches{0};  //Only counted in verify mode
+    std::atomic<int> rectsPending{0};                   //Rectangle tasks queued or running.  0 once the frame is finished.
+    void Reset() { filledPoints=0; fillMismatches=0; rectsPending=0; }
+};
+
+//One frame's worth of shared state.  Tasks hold it by shared_ptr, so it lives until the last rectangle is done.
+//calcRange iterates a range of points of the store it is given in place, e.g. msetBatch with the frame's maxIterations and CancelToken bound, and returns
+//the range actually finished, which is shorter if cancelled.
+template<class StoreType>
+class MarianiSilverFrame : public std::enable_shared_from_this<MarianiSilverFrame<StoreType>> {
+public:
+    MarianiSilverFrame(StoreType &pointsToCalc, int width, std::function<IndexRange(StoreType&,IndexRange)> calcRange, CancelToken cancel,
+                       ThreadPool &pool, ResultQueue<IndexRange> &completedRanges, MarianiSilverStats &stats, bool verify)
+        : points(pointsToCalc), res(width), calc(calcRange), cancel(cancel), pool(pool), completed(completedRanges), stats(stats), verify(verify) {}
+
+    //Queues a rectangle of the image.  Its border is computed by the first task, which then subdivides.
+    void Start(PixelRect r) {
+        stats.rectsPending++;
+        auto self=this->shared_from_this();
+        pool.Submit([self,r]() {
+            if (self->CalcRow(r.y0,r.x0,r.x1) && ((r.y1==r.y0) || self->CalcRow(r.y1,r.x0,r.x1))
+                && self->CalcColumn(r.x0,r.y0+1,r.y1-1) && ((r.x1==r.x0) || self->CalcColumn(r.x1,r.y0+1,r.y1-1))) {
+                self->Report({self->Index(r.x0,r.y0),self->Index(r.x1,r.y0)+1});
+                if (r.y1!=r.y0) self->Report({self->Index(r.x0,r.y1),self->Index(r.x1,r.y1)+1});
+                self->Rect(r.x0,r.y0,r.x1,r.y1,true,true);
+            }
+            self->stats.rectsPending--;
+        });
+    }
+
+private:
+    size_t Index(int x, int y) const { return (size_t)res*y+x; }
+    int Iterations(int x, int y) const { return points.iterations[Index(x,y)]; }
+
+    //Iterates pixels x0..x1 of row y.  Returns false if cancelled.
+    bool CalcRow(int y, int x0, int x1) {
+        if (x1<x0) return true;
+        IndexRange range={Index(x0,y),Index(x1,y)+1};
+        return calc(points,range).end==range.end;
+    }
+
+    //Iterates pixels y0..y1 of column x as one batch.  Returns false if cancelled.
+    bool CalcColumn(int x, int y0, int y1) {
+        if (y1<y0) return true;
+        std::vector<size_t> indices;
+        for (int y=y0;y<=y1;y++) {
+            indices.push_back(Index(x,y));
+            points.PrepareCoord(indices.back());
+        }
+        StoreType column;
+        column.Gather(points,indices);
+        if (calc(column,{0,column.Size()}).end!=column.Size()) return false;
+        column.Scatter(points);
+        return true;
+    }
+
+    void Report(IndexRange range) {
+        if (!cancel.Cancelled()) completed.Push(range);
+    }
+
+    //Reports the inside of row y of the rectangle x0..x1, with its border pixels on the sides it reports (see Rect)
+    void ReportRow(int y, int x0, int x1, bool left, bool right) {
+        IndexRange range={Index(x0+(left?0:1),y),Index(x1,y)+(right?1:0)};
+        if (range.Size()>0) Report(range);
+    }
+
+    //The border x0..x1 by y0..y1 is known.  Fills, iterates or splits the inside.  left and right say whether this rectangle reports the pixels of its left
+    //and right border columns between y0 and y1: true for a column computed but not yet reported.
+    void Rect(int x0, int y0, int x1, int y1, bool left, bool right) {
+        if (cancel.Cancelled()) return;
+        int insideWidth=x1-x0-1, insideHeight=y1-y0-1;
+        if (insideHeight<=0) return;
+        if (insideWidth<=0) {
+            for (int y=y0+1;y<y1;y++) ReportRow(y,x0,x1,left,right);
+            return;
+        }
+
+        int borderIterations=Iterations(x0,y0);
+        bool uniform=true;
+        for (int x=x0;(x<=x1)&&uniform;x++) uniform=(Iterations(x,y0)==borderIterations)&&(Iterations(x,y1)==borderIterations);
+        for (int y=y0+1;(y<y1)&&uniform;y++) uniform=(Iterations(x0,y)==borderIterations)&&(Iterations(x1,y)==borderIterations);
+
+        if (uniform) {
+            for (int y=y0+1;y<y1;y++) {
+                IndexRange row={Index(x0+1,y),Index(x1,y)};
+                if (verify) {  //Iterate a copy of the row directly and compare against the fill
+                    std::vector<size_t> indices;
+                    for (size_t i=row.start;i<row.end;i++) indices.push_back(i);
+                    points.PrepareCoords(row);
+                    StoreType check;
+                    check.Gather(points,indices);
+                    if (calc(check,{0,check.Size()}).end!=check.Size()) return;
+                    unsigned long long mismatches=0;
+                    for (int iterations:check.iterations) if (iterations!=borderIterations) mismatches++;
+                    stats.fillMismatches+=mismatches;
+                }
+                for (size_t i=row.start;i<row.end;i++) points.StoreResult(i,borderIterations);
+                stats.filledPoints+=insideWidth;
+                ReportRow(y,x0,x1,left,right);
+            }
+            return;
+        }
+
+        if ((insideWidth<marianiSilverMinInside)||(insideHeight<marianiSilverMinInside)) {
+            for (int y=y0+1;y<y1;y++) {
+                if (!CalcRow(y,x0+1,x1-1)) return;
+                ReportRow(y,x0,x1,left,right);
+            }
+            return;
+        }
+
+        //Split along the longer side.  The dividing line becomes part of both halves' borders.  A dividing column is reported by the left half.
+        if (insideWidth>=insideHeight) {
+            int xm=(x0+x1)/2;
+            if (!CalcColumn(xm,y0+1,y1-1)) return;
+            Submit(x0,y0,xm,y1,left,true);
+            Submit(xm,y0,x1,y1,false,right);
+        }
+        else {
+            int ym=(y0+y1)/2;
+            if (!CalcRow(ym,x0+1,x1-1)) return;
+            ReportRow(ym,x0,x1,left,right);
+            Submit(x0,y0,x1,ym,left,right);
+            Submit(x0,ym,x1,y1,left,right);
+        }
+    }
+
+    void Submit(int x0, int y0, int x1, int y1, bool left, bool right) {
+        stats.rectsPending++;
+        auto self=this->shared_from_this();
+        pool.Submit([self,x0,y0,x1,y1,left,right]() {
+            self->Rect(x0,y0,x1,y1,left,right);
+            self->stats.rectsPending--;
+        });
+    }
+
+    StoreType &points;
+    int res;
+    std::function<IndexRange(StoreType&,IndexRange)> calc;
+    CancelToken cancel;
+    ThreadPool &pool;
+    ResultQueue<IndexRange> &completed;
+    MarianiSilverStats &stats;
+    bool verify;
+};
+
+//Queues a Mariani-Silver render of the points in ranges of a res x res point store on the pool (see MarianiSilverRects)
+template<class StoreType>
+void StartMarianiSilver(StoreType &pointsToCalc, int res, const std::vector<IndexRange> &ranges, std::function<IndexRange(StoreType&,IndexRange)> calcRange,
+                        CancelToken cancel, ThreadPool &pool, ResultQueue<IndexRange> &completedRanges, MarianiSilverStats &stats, bool verify) {
+    auto frame=std::make_shared<MarianiSilverFrame<StoreType>>(pointsToCalc,res,calcRange,cancel,pool,completedRanges,stats,verify);
+    for (const PixelRect &r:MarianiSilverRects(ranges,res)) frame->Start(r);
+}
+
+#endif // MSETMARIANISILVER_HPP
@@ -0,0 +1,262 @@
+//Perturbation renderer for deep zooms.  One reference orbit Z_n is computed at the view center in a type's own (high) precision; every pixel then
+//iterates only its small offset from that orbit, delta_n = z_n - Z_n, in hardware doubles:
+//    delta_{n+1} = (2*Z_n + delta_n)*delta_n + deltaC
+//where deltaC is the pixel's offset from the center, which is exact in double because the pixel spacing is a power of two.
+//Past zoomDenomPower=extendedRangeZoomDenomPower the deltas would underflow double, so they are iterated in floatexp instead (see floatexp.hpp).
+//
+//Glitches (pixels whose delta stops tracking the true orbit because delta has grown comparable to z itself, or because the reference escaped
+//before the pixel did) are detected every iteration with the test |z_n| < |delta_n|, and the pixel is rebased: its current z becomes the new delta
+//against the start of the reference orbit (Z_0=0), which is the same as switching to a new reference whose orbit passes through z.  This is
+//Zhuoran's rebasing, and it removes the need for secondary reference points.  The number of rebases per frame is reported.
+//
+//On top of that, a series approximation lets every pixel skip the first iterations, where all pixels of the view still follow nearly the same orbit.  See SeriesApproximation.
+//
+//Results go into the same PointStore iteration arrays with the same conventions as msetPoint, so the difference screens work unchanged.
+#ifndef MSETPERTURBATION_HPP
+#define MSETPERTURBATION_HPP
+
+#include <vector>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include "msetCore.hpp"
+#include "floatexp.hpp"
+
+//Deltas switch from double to floatexp at this zoom.  A pixel offset of 2^-960 still leaves room below it for the products in the delta recurrence before double denormals.
+const unsigned int extendedRangeZoomDenomPower=960;
+
+//Counters a renderer accumulates across all batches of a frame.  Reset by the UI thread when a new frame starts.
+struct PerturbationStats {
+    std::atomic<unsigned long long> rebases{0};
+    std::atomic<int> referenceLength{0};
+    std::atomic<int> seriesSkip{0};
+    void Reset() { rebases=0; referenceLength=0; seriesSkip=0; }
+};
+
+//Reference orbit Z_0..Z_{length-1} rounded to double, plus the pixel geometry needed to turn a grid position into deltaC
+class PerturbationReference {
+public:
+    std::vector<double> Zr;
+    std::vector<double> Zi;
+    unsigned int zoomDenomPower=0;  //Pixel spacing is 1/2^zoomDenomPower
+    int halfRes=512;
+
+    //Iterates the center point in ComplexType's own precision, stopping at maxIterations or escape.  Returns false if cancelled.
+    template<class ComplexType>
+    bool Compute(ComplexType center, int maxIterations, unsigned int zoomDenom, int halfResolution, const CancelToken &cancel) {
+        zoomDenomPower=zoomDenom;
+        halfRes=halfResolution;
+        Zr.clear();
+        Zi.clear();
+        Zr.reserve(maxIterations+1);
+        Zi.reserve(maxIterations+1);
+        ComplexType z;
+        decltype(z.Magnitude()) maxMagnitude(4.0);
+        Zr.push_back(0.0);
+        Zi.push_back(0.0);
+        for (int n=0;n<maxIterations;n++) {
+            z=z.Squared()+center;
+            Zr.push_back(static_cast<double>(z.real));
+            Zi.push_back(static_cast<double>(z.imag));
+            if (!(z.Magnitude()<maxMagnitude)) break;
+            if ( ((n&cancelCheckMask)==0) && cancel.Cancelled() ) return false;
+        }
+        return true;
+    }
+
+    int Length() const { return (int)Zr.size(); }
+
+    //Exact offset from the center of a pixel gridOffset pixels away (x-halfRes for the real part, halfRes-y for the imaginary part)
+    template<class DeltaType> DeltaType PixelOffset(int gridOffset) const {
+        using std::ldexp;
+        return ldexp(DeltaType((double)gridOffset),-(int)zoomDenomPower);
+    }
+};
+
+//Largest relative error accepted from the series, both for the truncated term and at the probe pixels
+const double seriesTolerance=1e-12;
+
+//Truncated power series for delta_n in the pixel offset, valid for every pixel of the view up to iteration Skip():
+//    delta_n = sum_{k=1..order} a_k(n) u^k,   u = deltaC/radius
+//where radius is the largest |deltaC| in the view.  Scaling by radius keeps the coefficients near the size of delta itself rather than growing without bound.
+//The coefficients follow from substituting the series into the delta recurrence:
+//    a_k(n+1) = 2*Z_n*a_k(n) + sum_{i+j=k} a_i(n)*a_j(n)   (+ radius when k=1)
+//The skip is the last iteration at which the highest-order term is still negligible and the series matches probe pixels on the edge of the view, which are
+//iterated by plain perturbation alongside it.  Being a polynomial in a complex variable this is the usual bivariate approximation in the real and imaginary offsets.
+//DeltaType is double, or floatexp past extendedRangeZoomDenomPower.  Magnitudes are compared squared so neither needs a square root.
+template<class DeltaType>
+class SeriesApproximation {
+public:
+    //order=0 disables the approximation: Skip() is 0 and Evaluate() gives delta=0
+    void Compute(const PerturbationReference &ref, int maxIterations, int order, double tolerance, const CancelToken &cancel) {
+        skip=0;
+        coefR.assign(order,DeltaType(0.0));
+        coefI.assign(order,DeltaType(0.0));
+        radius=ref.PixelOffset<DeltaType>(ref.halfRes)*std::sqrt(2.0);
+        if (order<1) return;
+
+        const int numProbes=8;  //Corners and edge midpoints, as fractions of radius
+        const double h=std::sqrt(0.5);
+        const double probeUr[numProbes]={-h,h,h,-h,-h,h,0.0,0.0};
+        const double probeUi[numProbes]={h,h,-h,-h,0.0,0.0,h,-h};
+        DeltaType probeDr[numProbes], probeDi[numProbes];
+        for (int p=0;p<numProbes;p++) { probeDr[p]=DeltaType(0.0); probeDi[p]=DeltaType(0.0); }
+        std::vector<DeltaType> ar(order,DeltaType(0.0)), ai(order,DeltaType(0.0)), nr(order), ni(order);
+        const double tolSquared=tolerance*tolerance;
+        int lastN=std::min(ref.Length()-1,maxIterations-1);
+
+        for (int n=0;n<lastN;n++) {
+            double Zr2=2.0*ref.Zr[n], Zi2=2.0*ref.Zi[n];
+            for (int k=0;k<order;k++) {  //nr[k] is the coefficient of u^(k+1)
+                nr[k]=Zr2*ar[k]-Zi2*ai[k];
+                ni[k]=Zr2*ai[k]+Zi2*ar[k];
+                for (int i=0;i<k;i++) {  //u^(i+1) * u^(k-i) = u^(k+1)
+                    nr[k]+=ar[i]*ar[k-1-i]-ai[i]*ai[k-1-i];
+                    ni[k]+=ar[i]*ai[k-1-i]+ai[i]*ar[k-1-i];
+                }
+            }
+            nr[0]+=radius;
+
+            //Truncation: the last term kept must be negligible against the first at |u|=1
+            DeltaType first=nr[0]*nr[0]+ni[0]*ni[0];
+            if ( (order>1) && !(nr[order-1]*nr[order-1]+ni[order-1]*ni[order-1]<=tolSquared*first) ) break;
+
+            //Probe pixels must agree with the series and still be following the reference without glitching
+            bool valid=true;
+            for (int p=0;p<numProbes;p++) {
+                DeltaType dr=probeDr[p], di=probeDi[p];
+                DeltaType tr=Zr2+dr, ti=Zi2+di;
+                probeDr[p]=tr*dr-ti*di+probeUr[p]*radius;
+                probeDi[p]=tr*di+ti*dr+probeUi[p]*radius;
+                DeltaType sr, si;
+                EvaluateScaled(nr,ni,probeUr[p],probeUi[p],sr,si);
+                DeltaType zr=ref.Zr[n+1]+probeDr[p], zi=ref.Zi[n+1]+probeDi[p];
+                DeltaType zMag=zr*zr+zi*zi, dMag=probeDr[p]*probeDr[p]+probeDi[p]*probeDi[p];
+                DeltaType er=sr-probeDr[p], ei=si-probeDi[p];
+                if ( !(zMag<4.0) || (zMag<dMag) || !(er*er+ei*ei<=tolSquared*dMag) ) valid=false;
+            }
+            if (!valid) break;
+
+            ar.swap(nr);
+            ai.swap(ni);
+            skip=n+1;
+            if ( ((n&cancelCheckMask)==0) && cancel.Cancelled() ) { skip=0; return; }
+        }
+        coefR=ar;
+        coefI=ai;
+    }
+
+    int Skip() const { return skip; }
+
+    //delta at iteration Skip() for a pixel gridOffsetX, gridOffsetY pixels from the reference.  pixelsPerRadius is radius measured in pixels.
+    void Evaluate(int gridOffsetX, int gridOffsetY, double pixelsPerRadius, DeltaType &dr, DeltaType &di) const {
+        if (skip==0) { dr=DeltaType(0.0); di=DeltaType(0.0); return; }
+        EvaluateScaled(coefR,coefI,gridOffsetX/pixelsPerRadius,gridOffsetY/pixelsPerRadius,dr,di);
+    }
+
+private:
+    //Horner's rule on sum a_k u^k, k=1..order
+    static void EvaluateScaled(const std::vector<DeltaType> &ar, const std::vector<DeltaType> &ai, double ur, double ui, DeltaType &sr, DeltaType &si) {
+        sr=DeltaType(0.0); si=DeltaType(0.0);
+        for (int k=(int)ar.size()-1;k>=0;k--) {
+            DeltaType tr=sr+ar[k], ti=si+ai[k];
+            sr=tr*ur-ti*ui;
+            si=tr*ui+ti*ur;
+        }
+    }
+
+    int skip=0;
+    DeltaType radius=DeltaType(1.0);
+    std::vector<DeltaType> coefR;
+    std::vector<DeltaType> coefI;
+};
+
+//Iteration count for one pixel, same convention as msetPoint: escape iteration, or 0 if maxIterations is reached.  Returns -1 if cancelled.
+//startIteration and the starting delta come from a SeriesApproximation; by default the pixel starts from z=0.
+template<class DeltaType>
+inline int msetPointPerturbation(DeltaType dcr, DeltaType dci, int maxIterations, const PerturbationReference &ref, unsigned long long &rebases, const CancelToken &cancel,
+                                 int startIteration=0, DeltaType startDr=DeltaType(0.0), DeltaType startDi=DeltaType(0.0)) {
+    const double *Zr=ref.Zr.data();
+    const double *Zi=ref.Zi.data();
+    const int lastRef=ref.Length()-1;
+    DeltaType dr=startDr, di=startDi;  //delta_n
+    int m=startIteration;              //Index into the reference orbit, which restarts at 0 after a rebase
+    int iterationCounter=startIteration;
+
+    while (iterationCounter<maxIterations) {
+        DeltaType zr=Zr[m]+dr;
+        DeltaType zi=Zi[m]+di;
+        DeltaType zMag=zr*zr+zi*zi;
+        if (!(zMag<4.0)) break;  //Escaped.  Written this way round so NaN counts as escaped, as in msetPoint
+        if ( (zMag<dr*dr+di*di) || (m==lastRef) ) {  //Glitch, or the reference has run out: rebase onto Z_0=0
+            dr=zr;
+            di=zi;
+            m=0;
+            rebases++;
+        }
+        DeltaType tr=2.0*Zr[m]+dr;  //delta=(2Z+delta)*delta+deltaC
+        DeltaType ti=2.0*Zi[m]+di;
+        DeltaType ndr=tr*dr-ti*di+dcr;
+        di=tr*di+ti*dr+dci;
+        dr=ndr;
+        m++;
+        iterationCounter++;
+        if ( ((iterationCounter&cancelCheckMask)==0) && cancel.Cancelled() ) return -1;
+    }
+    return (iterationCounter<maxIterations)?iterationCounter:0;
+}
+
+//Batch wrapper in the style of msetBatch, for a PointStore of any precision.  deltaC comes from each point's grid position, so stored coordinates are not used,
+//but each point's is generated with its result (StoreResult) so that pans and zooms keep it.
+//series may be null, in which case every pixel starts from iteration 0.
+template<class DeltaType, class StoreType>
+IndexRange msetBatchPerturbation(StoreType &points, IndexRange range, int maxIterations, CancelToken cancel, const PerturbationReference &ref, PerturbationStats *stats,
+                                 const SeriesApproximation<DeltaType> *series=nullptr) {
+    unsigned long long rebases=0;
+    int skip=series?series->Skip():0;
+    double pixelsPerRadius=ref.halfRes*std::sqrt(2.0);
+    for (size_t i=range.start; i<range.end; i++) {
+        int_vector2 gridPos=points.GridPos(i);
+        int offsetX=gridPos.x-ref.halfRes;
+        int offsetY=ref.halfRes-gridPos.y;
+        DeltaType dr=DeltaType(0.0), di=DeltaType(0.0);
+        if (skip>0) series->Evaluate(offsetX,offsetY,pixelsPerRadius,dr,di);
+        int iterations=cancel.Cancelled()?-1:msetPointPerturbation<DeltaType>(ref.PixelOffset<DeltaType>(offsetX),ref.PixelOffset<DeltaType>(offsetY),maxIterations,ref,rebases,cancel,skip,dr,di);
+        if (iterations<0) {
+            range.end=i;
+            break;
+        }
+        points.StoreResult(i,iterations);
+    }
+    if (stats) stats->rebases+=rebases;
+return range;
+}
+
+//Everything the batches of one perturbation frame share: the reference orbit and the series approximation, in double or floatexp depending on the zoom
+class PerturbationFrame {
+public:
+    PerturbationReference ref;
+    SeriesApproximation<double> series;
+    SeriesApproximation<floatexp> seriesExtended;
+    bool extendedRange=false;
+
+    //Returns false if cancelled
+    template<class ComplexType>
+    bool Compute(ComplexType center, int maxIterations, unsigned int zoomDenomPower, int halfRes, int seriesOrder, const CancelToken &cancel) {
+        extendedRange=(zoomDenomPower>=extendedRangeZoomDenomPower);
+        if (!ref.Compute(center,maxIterations,zoomDenomPower,halfRes,cancel)) return false;
+        if (extendedRange) seriesExtended.Compute(ref,maxIterations,seriesOrder,seriesTolerance,cancel);
+        else series.Compute(ref,maxIterations,seriesOrder,seriesTolerance,cancel);
+        return !cancel.Cancelled();
+    }
+
+    int SeriesSkip() const { return extendedRange?seriesExtended.Skip():series.Skip(); }
+
+    template<class StoreType>
+    IndexRange Batch(StoreType &points, IndexRange range, int maxIterations, CancelToken cancel, PerturbationStats *stats) const {
+        if (extendedRange) return msetBatchPerturbation<floatexp>(points,range,maxIterations,cancel,ref,stats,&seriesExtended);
+        return msetBatchPerturbation<double>(points,range,maxIterations,cancel,ref,stats,&series);
+    }
+};
+
+#endif // MSETPERTURBATION_HPP
@@ -0,0 +1,55 @@
+//Every precision the engine in msetCore.hpp is built for, and runtime selection among them by name.  Each precision in EnginePrecisions gets its own
+//instantiation of whatever is dispatched to it, so its kernels are fully specialized and inlined; DispatchPrecision only picks which instantiation runs.
+//Used by msetBatchRender to render and compare any number of precisions without rebuilding.
+#ifndef MSETPRECISIONS_HPP
+#define MSETPRECISIONS_HPP
+
+#include <string>
+#include <vector>
+#include "msetCore.hpp"
+
+//Passed to dispatched functions to carry the precision as a type
+template<class Float> struct PrecisionTag { typedef Float type; };
+
+template<class... Floats> struct PrecisionList {};
+
+//Name a precision is selected by
+template<class Float> const char* PrecisionName();
+template<> inline const char* PrecisionName<double>() { return "double"; }
+template<> inline const char* PrecisionName<long double>() { return "long_double"; }
+template<> inline const char* PrecisionName<double_double>() { return "double_double"; }
+template<> inline const char* PrecisionName<quad_double>() { return "quad_double"; }
+template<> inline const char* PrecisionName<cpp_bin_float_single>() { return "cpp_bin_float_single"; }
+template<> inline const char* PrecisionName<cpp_bin_float_double>() { return "cpp_bin_float_double"; }
+template<> inline const char* PrecisionName<cpp_bin_float_double_extended>() { return "cpp_bin_float_double_extended"; }
+template<> inline const char* PrecisionName<cpp_bin_float_quad>() { return "cpp_bin_float_quad"; }
+template<> inline const char* PrecisionName<cpp_bin_float_oct>() { return "cpp_bin_float_oct"; }
+template<> inline const char* PrecisionName<cpp_bin_float_500>() { return "cpp_bin_float_500"; }
+template<> inline const char* PrecisionName<cpp_bin_float_1000>() { return "cpp_bin_float_1000"; }
+
+// OPTION: Precisions the engine is instantiated for.  To add a type, give it a PrecisionName above and list it here.  Each one adds to the build time.
+typedef PrecisionList<double, long double, double_double, quad_double,
+                      cpp_bin_float_single, cpp_bin_float_double, cpp_bin_float_double_extended, cpp_bin_float_quad, cpp_bin_float_oct,
+                      cpp_bin_float_500, cpp_bin_float_1000> EnginePrecisions;
+
+template<class... Floats>
+inline std::vector<std::string> PrecisionNames(PrecisionList<Floats...>) {
+    return {PrecisionName<Floats>()...};
+}
+
+//Calls visitor(PrecisionTag<Float>()) for the precision of the list called name.  The table holds one entry per precision, each calling the visitor's own
+//instantiation for that type.  Returns false if there is no such precision.
+template<class Visitor, class... Floats>
+inline bool DispatchPrecision(PrecisionList<Floats...>, const std::string &name, Visitor &&visitor) {
+    typedef void (*Entry)(Visitor&);
+    static const std::pair<const char*,Entry> table[]={ {PrecisionName<Floats>(), [](Visitor &v) { v(PrecisionTag<Floats>()); }}... };
+    for (const auto &entry:table) {
+        if (name==entry.first) {
+            entry.second(visitor);
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // MSETPRECISIONS_HPP
@@ -0,0 +1,139 @@
+//Progressive coarse-to-fine rendering.  Instead of walking the image in row-major order, every progressiveStartSpacing-th pixel in each direction is computed
+//first, then the pixels that halve the spacing, and so on down to every pixel.  Each level starts only once the one before it has finished, so the RayLib
+//explorer can draw every computed pixel as a block reaching to the next sample (see ProgressiveBlockSize) and finer levels always paint over coarser blocks.
+//Within a level, pixels in cells whose corner samples disagree are queued first, so detail fills in before flat areas.
+//Every pixel is still computed by the type's own kernel, so the finished image is exactly what batch rendering gives.
+#ifndef MSETPROGRESSIVE_HPP
+#define MSETPROGRESSIVE_HPP
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include "msetCore.hpp"
+#include "msetThreadPool.hpp"
+
+//Spacing of the first, coarsest level.  Must be a power of two.
+const int progressiveStartSpacing=16;
+
+struct ProgressiveStats {
+    std::atomic<int> tasksPending{0};  //Tasks queued or running.  0 once the frame is finished.
+    std::atomic<int> spacing{0};       //Spacing of the level being computed
+    void Reset() { tasksPending=0; spacing=0; }
+};
+
+//Size of the block a pixel stands for until finer levels fill it in: the spacing of the level that computes it
+inline int ProgressiveBlockSize(int_vector2 gridPos) {
+    int size=progressiveStartSpacing;
+    while ((size>1) && (((gridPos.x|gridPos.y)&(size-1))!=0)) size/=2;
+return size;
+}
+
+//One frame's worth of shared state, held by its tasks through shared_ptr as in MarianiSilverFrame.  calcRange has the same contract as there.
+template<class StoreType>
+class ProgressiveFrame : public std::enable_shared_from_this<ProgressiveFrame<StoreType>> {
+public:
+    ProgressiveFrame(StoreType &pointsToCalc, int width, std::function<IndexRange(StoreType&,IndexRange)> calcRange, CancelToken cancel,
+                     ThreadPool &pool, ResultQueue<IndexRange> &completedRanges, ProgressiveStats &stats, unsigned int batchSize)
+        : points(pointsToCalc), res(width), calc(calcRange), cancel(cancel), pool(pool), completed(completedRanges), stats(stats), batchSize(batchSize) {}
+
+    void Start() {
+        stats.tasksPending++;
+        auto self=this->shared_from_this();
+        pool.Submit([self]() {
+            self->Level(progressiveStartSpacing);
+            self->stats.tasksPending--;
+        });
+    }
+
+private:
+    int Iterations(int x, int y) const { return points.iterations[(size_t)res*y+x]; }
+
+    //True unless the corners of the cell of size cell around (x,y), as far as they are inside the image, all have the same count
+    bool CornersDisagree(int x, int y, int cell) {
+        int x0=x-x%cell, y0=y-y%cell;
+        int first=Iterations(x0,y0);
+        for (int cy=y0;cy<=y0+cell;cy+=cell) {
+            for (int cx=x0;cx<=x0+cell;cx+=cell) {
+                if ((cx<res)&&(cy<res)&&(Iterations(cx,cy)!=first)) return true;
+            }
+        }
+        return false;
+    }
+
+    //Queues the pixels of one level in batches, those in disagreeing cells first.  The last batch to finish starts the next level.
+    void Level(int spacing) {
+        if (cancel.Cancelled()) return;
+        stats.spacing=spacing;
+        std::vector<size_t> priority, rest;
+        for (int y=0;y<res;y+=spacing) {
+            for (int x=0;x<res;x+=spacing) {
+                if ((spacing<progressiveStartSpacing) && (((x|y)&(2*spacing-1))==0)) continue;  //Done at a coarser level
+                bool disagree=(spacing<progressiveStartSpacing) && CornersDisagree(x,y,2*spacing);
+                (disagree?priority:rest).push_back((size_t)res*y+x);
+            }
+        }
+        priority.insert(priority.end(),rest.begin(),rest.end());
+
+        std::vector<std::vector<size_t>> batches;
+        for (size_t i=0;i<priority.size();i+=batchSize) {
+            batches.emplace_back(priority.begin()+i,(i+batchSize<priority.size())?priority.begin()+i+batchSize:priority.end());
+        }
+        if (batches.empty()) {
+            if (spacing>1) Level(spacing/2);
+            return;
+        }
+        levelBatchesLeft=(int)batches.size();
+        auto self=this->shared_from_this();
+        for (std::vector<size_t> &batch:batches) {
+            stats.tasksPending++;
+            pool.Submit([self,batch,spacing]() {
+                bool finished=self->Compute(batch);
+                if ( (--self->levelBatchesLeft==0) && finished && (spacing>1) ) self->Level(spacing/2);
+                self->stats.tasksPending--;
+            });
+        }
+    }
+
+    //The pixels of a level are scattered, so they are gathered into a contiguous store for the kernel (which keeps the vector kernel's lanes full) and
+    //scattered back, orbit state included.  Runs of adjacent pixels are reported as one range.  Returns false if cancelled.
+    bool Compute(const std::vector<size_t> &batch) {
+        for (size_t i:batch) points.PrepareCoord(i);
+        StoreType scratch;
+        scratch.Gather(points,batch);
+        IndexRange done=calc(scratch,{0,scratch.Size()});
+        scratch.Scatter(points);
+        if ((done.end!=scratch.Size()) || cancel.Cancelled()) return false;
+
+        IndexRange run={batch[0],batch[0]+1};
+        for (size_t j=1;j<batch.size();j++) {
+            if (batch[j]==run.end) run.end++;
+            else {
+                completed.Push(run);
+                run={batch[j],batch[j]+1};
+            }
+        }
+        completed.Push(run);
+        return true;
+    }
+
+    StoreType &points;
+    int res;
+    std::function<IndexRange(StoreType&,IndexRange)> calc;
+    CancelToken cancel;
+    ThreadPool &pool;
+    ResultQueue<IndexRange> &completed;
+    ProgressiveStats &stats;
+    unsigned int batchSize;
+    std::atomic<int> levelBatchesLeft{0};
+};
+
+//Queues a progressive render of a res x res point store on the pool
+template<class StoreType>
+void StartProgressive(StoreType &pointsToCalc, int res, std::function<IndexRange(StoreType&,IndexRange)> calcRange, CancelToken cancel,
+                      ThreadPool &pool, ResultQueue<IndexRange> &completedRanges, ProgressiveStats &stats, unsigned int batchSize) {
+    auto frame=std::make_shared<ProgressiveFrame<StoreType>>(pointsToCalc,res,calcRange,cancel,pool,completedRanges,stats,batchSize);
+    frame->Start();
+}
+
+#endif // MSETPROGRESSIVE_HPP
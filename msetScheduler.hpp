@@ -0,0 +1,266 @@
+//Shares the worker threads among the explorer's three types by estimated cost, and sizes their batches.  A batch of the third type can take hundreds of
+//times longer than one of the first, so dealing batches out in turn leaves the first type finished in a moment and the third crawling long after.  Instead,
+//each type's tiles (see msetTiles.hpp) wait here, nearest the focus first, and the pool is given up to one interchangeable task per worker.  Each task takes
+//the next batch of tiles of the type chosen by the policy, runs it and queues itself again while any work is left:
+//  Balanced        the type with the most estimated work left, so every free core goes to the bottleneck and all three images finish at about the same time
+//  DisplayedFirst  the types on screen first, then as Balanced
+//A type's work left is its queued pixels times its iterations per pixel times its seconds per iteration.  Seconds per iteration is measured from every batch
+//the type runs and kept across frames, as it depends only on the type and the machine.  Iterations per pixel depends on the view, so it starts again on
+//every Clear(), and a type that has not finished a batch of the current view borrows the others' figure, since all three types render the same view.
+//A type never measured is picked first, so that every type has a cost before the estimates are used.
+//
+//Batches are sized from the same estimates to take about targetBatchSeconds: large enough on shallow views that queueing costs nothing next to the work, and
+//small enough on deep ones that progress shows steadily and the last batches of a frame do not leave one core working while the rest wait.  For the same
+//reason a batch is never more than a 1/(2 x workers) share of what the type has left, so batches shrink as the frame nears its end.  Until a type has been
+//measured its batches are the size it was added with.  Batches are whole tiles, so never less than one tile, however slow the type.
+//Mariani-Silver and progressive rendering queue their own tasks on the pool and are not scheduled here.
+#ifndef MSETSCHEDULER_HPP
+#define MSETSCHEDULER_HPP
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include "msetCore.hpp"
+#include "msetThreadPool.hpp"
+#include "msetTiles.hpp"
+#include "msetTrace.hpp"
+
+enum class SchedulePolicy { Balanced, DisplayedFirst };
+
+class BatchScheduler {
+public:
+    static const int numTypes=3;
+
+    // OPTION: Seconds each batch should take.  Shorter shows progress more smoothly, longer spends less time queueing.
+    double targetBatchSeconds=0.02;
+    size_t minBatchSize=64, maxBatchSize=65536;
+
+    //Queues the tiles of type 1-3 with points in ranges, nearest focus first, to be computed in batches of about initialBatchSize points until the type's
+    //cost is measured.  Only the points in ranges are computed.  calc iterates a range of points in place and returns the range finished, as for
+    //StartMarianiSilver.  Each finished tile is passed to finish, on the worker that computed it, e.g. to color it (see msetFramebuffer.hpp), and then pushed
+    //to completedTiles, unless cancelled.
+    template<class StoreType, class Calc, class Finish>
+    void AddTiles(ThreadPool &pool, int type, StoreType &points, const TileGrid &grid, const std::vector<IndexRange> &ranges, int_vector2 focus, Calc calc,
+                  Finish finish, CancelToken cancel, ResultQueue<TileResult> &completedTiles, size_t initialBatchSize) {
+        std::vector<TileResult> tiles=grid.TilesFor(ranges,focus);
+        auto runner=std::make_shared<const Runner>(Runner{[&points,grid,ranges,calc,finish,cancel,&completedTiles](TileResult tile, unsigned long long &iterations) {
+            for (int r=0;r<grid.tileSize;r++) {
+                bool finished=true;
+                ForEachRangeIn(ranges,grid.Row(tile.tile,r),[&](IndexRange part) {
+                    if (!finished) return;
+                    IterationCounter counter(points,part);
+                    IndexRange done=calc(points,part);
+                    iterations+=counter.Done(points,done);
+                    finished=(done.end==part.end);
+                });
+                if (!finished) return false;
+            }
+            if (cancel.Cancelled()) return false;
+            finish(tile);
+            completedTiles.Push(tile);
+            return true;
+        },cancel});
+        std::lock_guard<std::mutex> lock(m);
+        TypeState &t=types[type-1];
+        for (const TileResult &tile:tiles) {
+            t.tiles.push_back({tile,runner});
+            t.pointsQueued+=tile.points;
+        }
+        t.initialBatchSize=initialBatchSize;
+        workers=pool.Size();
+        while ((tasksQueued<workers) && HasWork()) {
+            tasksQueued++;
+            pool.Submit([this,&pool]() { RunNext(pool); });
+        }
+    }
+
+    //For a task that will add tiles of a type later: the type counts as pending until Release
+    void Hold(int type) { std::lock_guard<std::mutex> lock(m); types[type-1].holds++; }
+    void Release(int type) { std::lock_guard<std::mutex> lock(m); types[type-1].holds--; }
+
+    //Nonzero while a type has points queued or being computed, or is held.  Read it before taking the type's completed ranges: once it reads 0, every range has been pushed.
+    size_t Pending(int type) {
+        std::lock_guard<std::mutex> lock(m);
+        const TypeState &t=types[type-1];
+        return t.pointsQueued+t.pointsRunning+t.holds;
+    }
+
+    //Drops every queued tile, hold and the view's iterations per pixel.  Call once the pool has no tasks left, i.e. after ThreadPool::ClearPending and WaitIdle.
+    void Clear() {
+        std::lock_guard<std::mutex> lock(m);
+        for (TypeState &t:types) {
+            t.tiles.clear();
+            t.pointsQueued=0;
+            t.pointsRunning=0;
+            t.holds=0;
+            t.iterationsPerPixel=0.0;
+        }
+        tasksQueued=0;
+    }
+
+    //Forgets a type's measured cost, for when it changes kernel, e.g. to or from perturbation
+    void ResetEstimates(int type) {
+        std::lock_guard<std::mutex> lock(m);
+        types[type-1].secondsPerIteration=0.0;
+        types[type-1].iterationsPerPixel=0.0;
+    }
+
+    //Points per batch the type would get now, ignoring how much it has left.  For the progressive renderer, which sizes its own batches.
+    size_t BatchSize(int type, size_t initialBatchSize) {
+        std::lock_guard<std::mutex> lock(m);
+        return TunedBatchSize(type-1,initialBatchSize);
+    }
+
+    void SetPolicy(SchedulePolicy p) { policy=p; }
+    SchedulePolicy Policy() const { return policy; }
+    //Types on screen, as a bit mask: bit n-1 for type n
+    void SetDisplayedTypes(unsigned int mask) { displayedTypes=mask; }
+
+    //Estimated seconds of work queued for a type, for one core.  0 until the type has been measured.
+    double QueuedSeconds(int type) {
+        std::lock_guard<std::mutex> lock(m);
+        return QueuedCost(type-1);
+    }
+
+private:
+    //Computes a tile, adding the iterations done.  Returns false if cancelled.
+    typedef std::function<bool(TileResult,unsigned long long&)> TileRunner;
+    struct Runner {
+        TileRunner run;
+        CancelToken cancel;
+    };
+    struct QueuedTile {
+        TileResult tile;
+        std::shared_ptr<const Runner> runner;
+    };
+    struct TypeState {
+        std::deque<QueuedTile> tiles;
+        size_t pointsQueued=0, pointsRunning=0, holds=0;
+        size_t initialBatchSize=1024;
+        double secondsPerIteration=0.0;  //0 until measured
+        double iterationsPerPixel=0.0;   //0 until measured for the current view
+    };
+
+    //Weight of the newest batch in the running averages
+    static constexpr double smoothing=0.25;
+
+    //Guarded by m, as are the functions below
+    bool HasWork() const {
+        for (const TypeState &t:types) if (t.pointsQueued>0) return true;
+        return false;
+    }
+
+    double IterationsPerPixel(int t) const {
+        if (types[t].iterationsPerPixel>0.0) return types[t].iterationsPerPixel;
+        double sum=0.0;
+        int measured=0;
+        for (const TypeState &other:types) {
+            if (other.iterationsPerPixel>0.0) { sum+=other.iterationsPerPixel; measured++; }
+        }
+        return measured?sum/measured:1.0;
+    }
+
+    double QueuedCost(int t) const {
+        return types[t].pointsQueued*IterationsPerPixel(t)*types[t].secondsPerIteration;
+    }
+
+    size_t TunedBatchSize(int t, size_t initialBatchSize) const {
+        if (types[t].secondsPerIteration==0.0) return initialBatchSize;
+        double size=targetBatchSeconds/(types[t].secondsPerIteration*IterationsPerPixel(t));
+        return (size_t)std::max((double)minBatchSize,std::min((double)maxBatchSize,size));
+    }
+
+    //The type to run next, or -1 if none has points queued
+    int PickType() const {
+        unsigned int candidates=0;
+        for (int t=0;t<numTypes;t++) if (types[t].pointsQueued>0) candidates|=1u<<t;
+        if ((policy==SchedulePolicy::DisplayedFirst) && (candidates&displayedTypes)) candidates&=displayedTypes;
+        int best=-1;
+        double bestCost=-1.0;
+        for (int t=0;t<numTypes;t++) {
+            if (!(candidates&(1u<<t))) continue;
+            if (types[t].secondsPerIteration==0.0) return t;
+            double cost=QueuedCost(t);
+            if (cost>bestCost) { best=t; bestCost=cost; }
+        }
+        return best;
+    }
+
+    //Drops the tiles of a cancelled generation, which are always at the front, since each generation's are added after the last's
+    static void DropCancelled(TypeState &state) {
+        while (!state.tiles.empty() && state.tiles.front().runner->cancel.Cancelled()) {
+            state.pointsQueued-=state.tiles.front().tile.points;
+            state.tiles.pop_front();
+        }
+    }
+
+    //Takes the next batch of type t: tiles from the front of its queue, all added together
+    bool TakeBatch(int t, std::vector<TileResult> &batch, std::shared_ptr<const Runner> &runner) {
+        TypeState &state=types[t];
+        DropCancelled(state);
+        if (state.tiles.empty()) return false;
+        size_t tailShare=std::max(minBatchSize,state.pointsQueued/(2*workers));
+        size_t size=std::min(TunedBatchSize(t,state.initialBatchSize),tailShare), points=0;
+        batch.clear();
+        runner=state.tiles.front().runner;
+        while (!state.tiles.empty() && (state.tiles.front().runner==runner) && (batch.empty() || (points+state.tiles.front().tile.points<=size))) {
+            batch.push_back(state.tiles.front().tile);
+            points+=batch.back().points;
+            state.tiles.pop_front();
+        }
+        state.pointsQueued-=points;
+        state.pointsRunning+=points;
+        return true;
+    }
+
+    void RunNext(ThreadPool &pool) {
+        int t;
+        std::vector<TileResult> batch;
+        std::shared_ptr<const Runner> runner;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            do t=PickType(); while ((t>=0) && !TakeBatch(t,batch,runner));
+            if (t<0) {
+                tasksQueued--;
+                return;
+            }
+        }
+        MSET_TRACE_BEGIN(span,"batch",t+1);
+        unsigned long long iterations=0;
+        size_t points=0, done=0;
+        auto start=std::chrono::steady_clock::now();
+        for (const TileResult &tile:batch) {
+            points+=tile.points;
+            if (runner->run(tile,iterations)) done+=tile.points;
+        }
+        double seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+        MSET_TRACE_END_BATCH(span,t+1,done,iterations);
+
+        std::lock_guard<std::mutex> lock(m);
+        TypeState &state=types[t];
+        state.pointsRunning-=points;
+        if ((done>0) && (iterations>0)) {  //Cancelled, or nothing left to iterate, says nothing about cost
+            double secondsPerIteration=seconds/iterations, iterationsPerPixel=(double)iterations/done;
+            state.secondsPerIteration=(state.secondsPerIteration==0.0)?secondsPerIteration:state.secondsPerIteration+smoothing*(secondsPerIteration-state.secondsPerIteration);
+            state.iterationsPerPixel=(state.iterationsPerPixel==0.0)?iterationsPerPixel:state.iterationsPerPixel+smoothing*(iterationsPerPixel-state.iterationsPerPixel);
+        }
+        //Tiles of a cancelled view do not count: the UI thread may have cleared the pool since they were queued, and paused it, and would then wait on a
+        //task no worker will take
+        for (TypeState &other:types) DropCancelled(other);
+        if (HasWork()) pool.Submit([this,&pool]() { RunNext(pool); });
+        else tasksQueued--;
+    }
+
+    std::mutex m;
+    TypeState types[numTypes];
+    size_t tasksQueued=0;  //Tasks of RunNext on the pool, queued or running
+    size_t workers=1;
+    std::atomic<SchedulePolicy> policy{SchedulePolicy::Balanced};
+    std::atomic<unsigned int> displayedTypes{0};
+};
+
+#endif // MSETSCHEDULER_HPP
@@ -0,0 +1,96 @@
+//Checks of the batch scheduler and thread pool that the explorer relies on but cannot easily show going wrong, as the explorer would just hang.  Each check
+//prints OK or FAIL, and the exit code is the number that failed.  A check that would hang fails after a timeout instead.
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <future>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+
+#include "msetCore.hpp"
+#include "msetThreadPool.hpp"
+#include "msetScheduler.hpp"
+#include "msetTiles.hpp"
+
+using namespace std;
+
+typedef PointStore<double> TestStore;
+
+//Long enough for anything that is going to finish
+const chrono::seconds timeout(5);
+
+//Waits for the pool as the explorer's stopAllBatches does, and gives up after timeout.  The waiting thread is detached, as it may never return.
+bool WaitIdleWithin(ThreadPool &pool) {
+    auto idle=make_shared<promise<void>>();
+    future<void> done=idle->get_future();
+    thread([&pool,idle]() { pool.WaitIdle(); idle->set_value(); }).detach();
+    return done.wait_for(timeout)==future_status::ready;
+}
+
+bool Report(const char *name, bool ok) {
+    cout<<(ok?"OK   ":"FAIL ")<<name<<endl;
+    return ok;
+}
+
+//Every queued tile is computed, finished and pushed once, and the type is then no longer pending
+bool CheckAllTilesFinish(const TileGrid &grid) {
+    ThreadPool pool(2);
+    BatchScheduler scheduler;
+    TestStore points(grid.res);
+    atomic<unsigned int> generation(0);
+    CancelToken cancel={&generation,0};
+    ResultQueue<TileResult> completedTiles;
+    atomic<int> finished(0);
+    scheduler.AddTiles(pool,1,points,grid,{{0,points.Size()}},{grid.res/2,grid.res/2},[](TestStore&, IndexRange range) { return range; },
+                       [&finished](TileResult) { finished++; },cancel,completedTiles,64);
+    bool idle=WaitIdleWithin(pool);
+    vector<TileResult> tiles;
+    completedTiles.TakeAll(tiles);
+    return Report("all tiles finish",idle && (finished==grid.Count()) && ((int)tiles.size()==grid.Count()) && (scheduler.Pending(1)==0));
+}
+
+//The pool is paused and the view cancelled while every worker is in the middle of a batch, with more tiles queued.  The running batches must not queue
+//more work once the pool has been cleared, or no paused worker would take it and waiting for the pool would never return.
+bool CheckCancelWhilePaused(const TileGrid &grid) {
+    ThreadPool pool(2);
+    BatchScheduler scheduler;
+    TestStore points(grid.res);
+    atomic<unsigned int> generation(0);
+    CancelToken cancel={&generation,0};
+    ResultQueue<TileResult> completedTiles;
+    atomic<unsigned int> started(0);
+    auto calc=[&started,cancel](TestStore&, IndexRange range) {
+        started++;
+        while (!cancel.Cancelled()) this_thread::sleep_for(chrono::milliseconds(1));
+        return IndexRange{range.start,range.start};
+    };
+    scheduler.AddTiles(pool,1,points,grid,{{0,points.Size()}},{grid.res/2,grid.res/2},calc,[](TileResult) {},cancel,completedTiles,64);
+    auto start=chrono::steady_clock::now();
+    while ((started<pool.Size()) && (chrono::steady_clock::now()-start<timeout)) this_thread::sleep_for(chrono::milliseconds(1));
+    if (started<pool.Size()) return Report("cancel while paused (workers never started)",false);
+
+    pool.SetPaused(true);
+    generation++;
+    pool.ClearPending();
+    if (!WaitIdleWithin(pool)) {
+        Report("cancel while paused",false);
+        cout.flush();
+        _Exit(1);  //The workers are stuck, so the pool cannot be destroyed
+    }
+    scheduler.Clear();
+    pool.SetPaused(false);
+    return Report("cancel while paused",scheduler.Pending(1)==0);
+}
+
+int main() {
+    TileGrid grid;
+    grid.res=128;
+    grid.tileSize=16;
+    int failed=0;
+    failed+=!CheckAllTilesFinish(grid);
+    failed+=!CheckCancelWhilePaused(grid);
+    cout<<(failed?"Some checks failed":"All checks passed")<<endl;
+return failed;
+}
@@ -0,0 +1,312 @@
+//Vectorized escape-time kernel for double.  Iterates 4 (AVX2) or 8 (AVX-512) pixels in lockstep; lanes whose pixel has escaped
+//or hit max iterations store their result and are refilled with the next pixel of the batch, so all lanes stay busy until the batch runs out.
+//The kernel is picked at runtime from what the CPU supports, with msetBatch<double> as the fallback.  msetBatchSimd takes any precision, so callers need not
+//know whether a type has a vector kernel.
+//
+//Every lane performs exactly the same IEEE operations, in the same order, as MyComplex<double>::Squared(), operator+ and Magnitude(), and the same
+//periodicity check as msetPoint, so iteration counts are identical to the scalar kernel.  That only holds if the compiler does not fuse multiplies and adds into FMAs in the scalar code either: if you build with
+//-march=native or any other flags that enable FMA, also pass -ffp-contract=off.
+#ifndef MSETSIMD_HPP
+#define MSETSIMD_HPP
+
+#include <type_traits>
+#include "msetCore.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MSET_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+enum SimdLevel { simdScalar=0, simdAVX2=4, simdAVX512=8 };  //Values are the lane count
+
+inline const char* SimdLevelName(SimdLevel level) {
+    if (level==simdAVX512) return "AVX-512 (8 lanes)";
+    if (level==simdAVX2) return "AVX2 (4 lanes)";
+    return "scalar";
+}
+
+//Widest kernel usable on this CPU for double
+inline SimdLevel DetectSimdLevel() {
+#ifdef MSET_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return simdAVX512;
+    if (__builtin_cpu_supports("avx2")) return simdAVX2;
+#endif
+    return simdScalar;
+}
+
+#ifdef MSET_X86_SIMD
+//GCC's intrinsics are plain vector arithmetic, which it would otherwise be free to contract into FMAs on AVX-512 targets
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+
+//Lane bookkeeping shared by both widths.  Loads the next pixel of the batch into lane l, or parks the lane if the batch is used up.
+//A parked lane has its counter at maxIterations so it never counts as active.
+struct SimdLanes {
+    double zr[8], zi[8], cr[8], ci[8], cnt[8];
+    double sr[8], si[8], saveAt[8];  //Periodicity check: saved orbit value and the iteration at which to save the next one
+    double start[8];                 //Iteration the lane's orbit resumed from.  The periodicity check starts after it.
+    size_t index[8];
+    bool busy[8];
+    PointStore<double> &points;
+    KernelSettings<double> settings;
+    unsigned long long interiorPoints=0;
+
+    SimdLanes(PointStore<double> &pointStore) : points(pointStore) {}
+
+    void Refill(int l, size_t &next, size_t end, int maxIterations) {
+        while (next<end) {  //Same known-interior and interior test handling as msetBatch and msetPoint
+            if (points.orbitIterations[next]<0) points.iterations[next]=0;
+            else if (settings.checkInterior && (points.orbitIterations[next]==0) && InKnownComponent(points.Coord(next))) {
+                points.iterations[next]=0;
+                points.orbitIterations[next]=-1;
+                interiorPoints++;
+            }
+            else break;
+            next++;
+        }
+        if (next<end) {  //Resume the orbit where it was left, as msetPoint does
+            index[l]=next;
+            cr[l]=points.coordReal[next];
+            ci[l]=points.coordImag[next];
+            zr[l]=points.zReal[next];
+            zi[l]=points.zImag[next];
+            cnt[l]=(double)points.orbitIterations[next];
+            start[l]=cnt[l];
+            sr[l]=zr[l]; si[l]=zi[l];
+            saveAt[l]=(points.orbitIterations[next]>0)?2.0*cnt[l]:1.0;
+            busy[l]=true;
+            next++;
+        }
+        else {
+            zr[l]=0.0; zi[l]=0.0; cr[l]=0.0; ci[l]=0.0;
+            sr[l]=0.0; si[l]=0.0; saveAt[l]=1.0;
+            cnt[l]=(double)maxIterations;
+            start[l]=0.0;
+            busy[l]=false;
+        }
+    }
+
+    //Same rule as msetPoint: escaped points keep their count, points that hit max iterations get 0, and the orbit is kept for resuming
+    void Finish(int l, int maxIterations, bool periodic) {
+        int iterationCounter=(int)cnt[l];
+        size_t i=index[l];
+        points.iterations[i]=(iterationCounter<maxIterations && !periodic)?iterationCounter:0;
+        points.zReal[i]=zr[l];
+        points.zImag[i]=zi[l];
+        points.orbitIterations[i]=periodic?-1:iterationCounter;
+    }
+
+    //On cancel, keeps how far each loaded point got so it can be resumed.  zr, zi and cnt must have been stored from the registers first.
+    void SaveProgress(int lanes) {
+        for (int l=0;l<lanes;l++) {
+            if (!busy[l]) continue;
+            points.zReal[index[l]]=zr[l];
+            points.zImag[index[l]]=zi[l];
+            points.orbitIterations[index[l]]=(int)cnt[l];
+        }
+    }
+
+    //Points before the earliest point still loaded in a lane are all finished
+    size_t FirstUnfinished(int lanes, size_t next) {
+        for (int l=0;l<lanes;l++) if (busy[l] && (index[l]<next)) next=index[l];
+        return next;
+    }
+};
+
+__attribute__((target("avx2")))
+inline IndexRange msetBatchAVX2(PointStore<double> &points, IndexRange range, int maxIterations, CancelToken cancel) {
+    points.PrepareCoords(range);
+    SimdLanes lanes(points);
+    size_t next=range.start;
+    for (int l=0;l<4;l++) lanes.Refill(l,next,range.end,maxIterations);
+    __m256d zr=_mm256_loadu_pd(lanes.zr), zi=_mm256_loadu_pd(lanes.zi), cr=_mm256_loadu_pd(lanes.cr), ci=_mm256_loadu_pd(lanes.ci), cnt=_mm256_loadu_pd(lanes.cnt);
+    __m256d sr=_mm256_loadu_pd(lanes.sr), si=_mm256_loadu_pd(lanes.si), saveAt=_mm256_loadu_pd(lanes.saveAt), start=_mm256_loadu_pd(lanes.start);
+    const __m256d four=_mm256_set1_pd(4.0), one=_mm256_set1_pd(1.0), maxIter=_mm256_set1_pd((double)maxIterations);
+    const bool checkPeriod=lanes.settings.checkPeriod;
+    const __m256d periodTolerance=_mm256_set1_pd(lanes.settings.periodTolerance), absMask=_mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    unsigned int loopCounter=0;
+    unsigned long long periodicPoints=0;
+
+    while (true) {
+        __m256d rr=_mm256_mul_pd(zr,zr);
+        __m256d ii=_mm256_mul_pd(zi,zi);
+        __m256d ri=_mm256_mul_pd(zr,zi);
+        __m256d mag=_mm256_add_pd(rr,ii);
+        __m256d active=_mm256_and_pd(_mm256_cmp_pd(mag,four,_CMP_LT_OQ),_mm256_cmp_pd(cnt,maxIter,_CMP_LT_OQ));
+        int periodicBits=0;
+
+        if (checkPeriod) {  //Lanes back within tolerance of their saved value are interior: park them at maxIterations so Finish() stores 0
+            __m256d near=_mm256_and_pd(_mm256_cmp_pd(_mm256_and_pd(_mm256_sub_pd(zr,sr),absMask),periodTolerance,_CMP_LT_OQ),
+                                       _mm256_cmp_pd(_mm256_and_pd(_mm256_sub_pd(zi,si),absMask),periodTolerance,_CMP_LT_OQ));
+            __m256d periodic=_mm256_and_pd(_mm256_and_pd(active,_mm256_cmp_pd(cnt,start,_CMP_GT_OQ)),near);
+            periodicBits=_mm256_movemask_pd(periodic);
+            if (periodicBits) {
+                periodicPoints+=__builtin_popcount(periodicBits);
+                cnt=_mm256_blendv_pd(cnt,maxIter,periodic);
+                active=_mm256_andnot_pd(periodic,active);
+            }
+        }
+        int activeBits=_mm256_movemask_pd(active);
+
+        if (activeBits!=0xF) {  //Some lane is finished or parked
+            _mm256_storeu_pd(lanes.zr,zr); _mm256_storeu_pd(lanes.zi,zi); _mm256_storeu_pd(lanes.cr,cr); _mm256_storeu_pd(lanes.ci,ci); _mm256_storeu_pd(lanes.cnt,cnt);
+            _mm256_storeu_pd(lanes.sr,sr); _mm256_storeu_pd(lanes.si,si); _mm256_storeu_pd(lanes.saveAt,saveAt); _mm256_storeu_pd(lanes.start,start);
+            bool changed=false, anyBusy=false;
+            for (int l=0;l<4;l++) {
+                if ( !(activeBits&(1<<l)) && lanes.busy[l] ) {
+                    lanes.Finish(l,maxIterations,periodicBits&(1<<l));
+                    lanes.Refill(l,next,range.end,maxIterations);
+                    changed=true;
+                }
+                anyBusy|=lanes.busy[l];
+            }
+            if (!anyBusy) break;
+            if (changed) {  //Reload and re-test: refilled lanes start again from their point's saved orbit
+                zr=_mm256_loadu_pd(lanes.zr); zi=_mm256_loadu_pd(lanes.zi); cr=_mm256_loadu_pd(lanes.cr); ci=_mm256_loadu_pd(lanes.ci); cnt=_mm256_loadu_pd(lanes.cnt);
+                sr=_mm256_loadu_pd(lanes.sr); si=_mm256_loadu_pd(lanes.si); saveAt=_mm256_loadu_pd(lanes.saveAt); start=_mm256_loadu_pd(lanes.start);
+                continue;
+            }
+        }
+
+        if (checkPeriod) {  //Save z in lanes that have reached their next power-of-two iteration
+            __m256d save=_mm256_and_pd(active,_mm256_cmp_pd(cnt,saveAt,_CMP_EQ_OQ));
+            sr=_mm256_blendv_pd(sr,zr,save);
+            si=_mm256_blendv_pd(si,zi,save);
+            saveAt=_mm256_blendv_pd(saveAt,_mm256_add_pd(saveAt,saveAt),save);
+        }
+
+        //z=z^2+c in the same operation order as MyComplex, only for active lanes
+        __m256d newzr=_mm256_add_pd(_mm256_sub_pd(rr,ii),cr);
+        __m256d newzi=_mm256_add_pd(_mm256_add_pd(ri,ri),ci);
+        zr=_mm256_blendv_pd(zr,newzr,active);
+        zi=_mm256_blendv_pd(zi,newzi,active);
+        cnt=_mm256_add_pd(cnt,_mm256_and_pd(active,one));
+
+        if ( ((++loopCounter&cancelCheckMask)==0) && cancel.Cancelled() ) {
+            _mm256_storeu_pd(lanes.zr,zr); _mm256_storeu_pd(lanes.zi,zi); _mm256_storeu_pd(lanes.cnt,cnt);
+            lanes.SaveProgress(4);
+            range.end=lanes.FirstUnfinished(4,next);
+            PeriodicPoints<double>()+=periodicPoints;
+            InteriorTestPoints<double>()+=lanes.interiorPoints;
+            return range;
+        }
+    }
+    PeriodicPoints<double>()+=periodicPoints;
+    InteriorTestPoints<double>()+=lanes.interiorPoints;
+return range;
+}
+
+__attribute__((target("avx512f")))
+inline IndexRange msetBatchAVX512(PointStore<double> &points, IndexRange range, int maxIterations, CancelToken cancel) {
+    points.PrepareCoords(range);
+    SimdLanes lanes(points);
+    size_t next=range.start;
+    for (int l=0;l<8;l++) lanes.Refill(l,next,range.end,maxIterations);
+    __m512d zr=_mm512_loadu_pd(lanes.zr), zi=_mm512_loadu_pd(lanes.zi), cr=_mm512_loadu_pd(lanes.cr), ci=_mm512_loadu_pd(lanes.ci), cnt=_mm512_loadu_pd(lanes.cnt);
+    __m512d sr=_mm512_loadu_pd(lanes.sr), si=_mm512_loadu_pd(lanes.si), saveAt=_mm512_loadu_pd(lanes.saveAt), start=_mm512_loadu_pd(lanes.start);
+    const __m512d four=_mm512_set1_pd(4.0), one=_mm512_set1_pd(1.0), maxIter=_mm512_set1_pd((double)maxIterations);
+    const bool checkPeriod=lanes.settings.checkPeriod;
+    const __m512d periodTolerance=_mm512_set1_pd(lanes.settings.periodTolerance);
+    unsigned int loopCounter=0;
+    unsigned long long periodicPoints=0;
+
+    while (true) {
+        __m512d rr=_mm512_mul_pd(zr,zr);
+        __m512d ii=_mm512_mul_pd(zi,zi);
+        __m512d ri=_mm512_mul_pd(zr,zi);
+        __m512d mag=_mm512_add_pd(rr,ii);
+        __mmask8 active=_mm512_cmp_pd_mask(mag,four,_CMP_LT_OQ) & _mm512_cmp_pd_mask(cnt,maxIter,_CMP_LT_OQ);
+        __mmask8 periodic=0;
+
+        if (checkPeriod) {
+            periodic=active & _mm512_cmp_pd_mask(cnt,start,_CMP_GT_OQ)
+                              & _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_sub_pd(zr,sr)),periodTolerance,_CMP_LT_OQ)
+                              & _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_sub_pd(zi,si)),periodTolerance,_CMP_LT_OQ);
+            if (periodic) {
+                periodicPoints+=__builtin_popcount(periodic);
+                cnt=_mm512_mask_blend_pd(periodic,cnt,maxIter);
+                active&=~periodic;
+            }
+        }
+
+        if (active!=0xFF) {
+            _mm512_storeu_pd(lanes.zr,zr); _mm512_storeu_pd(lanes.zi,zi); _mm512_storeu_pd(lanes.cr,cr); _mm512_storeu_pd(lanes.ci,ci); _mm512_storeu_pd(lanes.cnt,cnt);
+            _mm512_storeu_pd(lanes.sr,sr); _mm512_storeu_pd(lanes.si,si); _mm512_storeu_pd(lanes.saveAt,saveAt); _mm512_storeu_pd(lanes.start,start);
+            bool changed=false, anyBusy=false;
+            for (int l=0;l<8;l++) {
+                if ( !(active&(1<<l)) && lanes.busy[l] ) {
+                    lanes.Finish(l,maxIterations,periodic&(1<<l));
+                    lanes.Refill(l,next,range.end,maxIterations);
+                    changed=true;
+                }
+                anyBusy|=lanes.busy[l];
+            }
+            if (!anyBusy) break;
+            if (changed) {
+                zr=_mm512_loadu_pd(lanes.zr); zi=_mm512_loadu_pd(lanes.zi); cr=_mm512_loadu_pd(lanes.cr); ci=_mm512_loadu_pd(lanes.ci); cnt=_mm512_loadu_pd(lanes.cnt);
+                sr=_mm512_loadu_pd(lanes.sr); si=_mm512_loadu_pd(lanes.si); saveAt=_mm512_loadu_pd(lanes.saveAt); start=_mm512_loadu_pd(lanes.start);
+                continue;
+            }
+        }
+
+        if (checkPeriod) {
+            __mmask8 save=active & _mm512_cmp_pd_mask(cnt,saveAt,_CMP_EQ_OQ);
+            sr=_mm512_mask_blend_pd(save,sr,zr);
+            si=_mm512_mask_blend_pd(save,si,zi);
+            saveAt=_mm512_mask_add_pd(saveAt,save,saveAt,saveAt);
+        }
+
+        __m512d newzr=_mm512_add_pd(_mm512_sub_pd(rr,ii),cr);
+        __m512d newzi=_mm512_add_pd(_mm512_add_pd(ri,ri),ci);
+        zr=_mm512_mask_blend_pd(active,zr,newzr);
+        zi=_mm512_mask_blend_pd(active,zi,newzi);
+        cnt=_mm512_mask_add_pd(cnt,active,cnt,one);
+
+        if ( ((++loopCounter&cancelCheckMask)==0) && cancel.Cancelled() ) {
+            _mm512_storeu_pd(lanes.zr,zr); _mm512_storeu_pd(lanes.zi,zi); _mm512_storeu_pd(lanes.cnt,cnt);
+            lanes.SaveProgress(8);
+            range.end=lanes.FirstUnfinished(8,next);
+            PeriodicPoints<double>()+=periodicPoints;
+            InteriorTestPoints<double>()+=lanes.interiorPoints;
+            return range;
+        }
+    }
+    PeriodicPoints<double>()+=periodicPoints;
+    InteriorTestPoints<double>()+=lanes.interiorPoints;
+return range;
+}
+
+#pragma GCC pop_options
+#endif // MSET_X86_SIMD
+
+//Kernel used by msetBatchSimd for double.  Detected once; may be lowered (never raised) with LimitSimdLevel(), e.g. to compare kernels.
+inline SimdLevel& ActiveSimdLevel() {
+    static SimdLevel level=DetectSimdLevel();
+    return level;
+}
+
+inline void LimitSimdLevel(SimdLevel maxLevel) {
+    if (maxLevel<ActiveSimdLevel()) ActiveSimdLevel()=maxLevel;
+}
+
+//Kernel a precision's batches run on: scalar if there is no vector kernel for it
+template<class Float>
+inline SimdLevel KernelSimdLevel() {
+    return std::is_same<Float,double>::value?ActiveSimdLevel():simdScalar;
+}
+
+//Drop-in replacement for msetBatch that uses the widest vector kernel available for the precision
+template<class Float>
+inline IndexRange msetBatchSimd(PointStore<Float> &points, IndexRange range, int maxIterations, CancelToken cancel=CancelToken()) {
+#ifdef MSET_X86_SIMD
+    if constexpr (std::is_same<Float,double>::value) {
+        SimdLevel level=ActiveSimdLevel();
+        if (level==simdAVX512) return msetBatchAVX512(points,range,maxIterations,cancel);
+        if (level==simdAVX2) return msetBatchAVX2(points,range,maxIterations,cancel);
+    }
+#endif
+    return msetBatch(points,range,maxIterations,cancel);
+}
+
+#endif // MSETSIMD_HPP
@@ -0,0 +1,172 @@
+//Persistent work-stealing thread pool shared by the RayLib explorer and the headless renderer.
+//Each worker owns a deque of tasks.  Submitted tasks are dealt round-robin to the deques; a worker takes work from the front of its own deque
+//(so each deque is worked through in submission order and the image fills roughly top to bottom) and, when that is empty, steals from the back of another worker's deque.
+//Workers never wait on the UI thread: they keep pulling batches for all three float types until every deque is empty.
+#ifndef MSETTHREADPOOL_HPP
+#define MSETTHREADPOOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class ThreadPool {
+public:
+    //numThreads=0 means one worker per hardware thread
+    explicit ThreadPool(unsigned int numThreads=0) {
+        if (numThreads==0) numThreads=std::thread::hardware_concurrency();
+        if (numThreads==0) numThreads=1;  //hardware_concurrency() may return 0 if it cannot tell
+        for (unsigned int t=0;t<numThreads;t++) queues.emplace_back(new WorkerQueue);
+        for (unsigned int t=0;t<numThreads;t++) workers.emplace_back(&ThreadPool::WorkerLoop,this,t);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping=true;
+        }
+        wake.notify_all();
+        for (auto &w:workers) w.join();
+    }
+
+    ThreadPool(const ThreadPool&)=delete;
+    ThreadPool& operator=(const ThreadPool&)=delete;
+
+    unsigned int Size() const { return (unsigned int)workers.size(); }
+
+    void Submit(std::function<void()> task) {
+        unsigned int q=nextQueue++%queues.size();
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);  //Count first so the counter never dips below the number of queued tasks
+            queuedTasks++;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[q]->m);
+            queues[q]->tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+    //Discards every task that has not started yet.  Tasks already running are not interrupted.
+    void ClearPending() {
+        size_t dropped=0;
+        for (auto &q:queues) {
+            std::lock_guard<std::mutex> lock(q->m);
+            dropped+=q->tasks.size();
+            q->tasks.clear();
+        }
+        if (dropped>0) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            queuedTasks-=dropped;
+        }
+        idle.notify_all();
+    }
+
+    //Blocks until there are no queued or running tasks
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        idle.wait(lock,[this]{ return (queuedTasks==0)&&(runningTasks==0); });
+    }
+
+    //Paused workers finish their current task and then take no more until unpaused
+    void SetPaused(bool p) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            paused=p;
+        }
+        wake.notify_all();
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex m;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool PopOrSteal(unsigned int self, std::function<void()> &task) {
+        {
+            std::lock_guard<std::mutex> lock(queues[self]->m);
+            if (!queues[self]->tasks.empty()) {
+                task=std::move(queues[self]->tasks.front());
+                queues[self]->tasks.pop_front();
+                return true;
+            }
+        }
+        for (size_t i=1;i<queues.size();i++) {
+            WorkerQueue &victim=*queues[(self+i)%queues.size()];
+            std::lock_guard<std::mutex> lock(victim.m);
+            if (!victim.tasks.empty()) {
+                task=std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkerLoop(unsigned int self) {
+        std::function<void()> task;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wake.wait(lock,[this]{ return stopping || (!paused && queuedTasks>0); });
+                if (stopping) return;
+            }
+            if (!PopOrSteal(self,task)) {  //Another worker took it first, or ClearPending() dropped it
+                std::this_thread::yield();
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                queuedTasks--;
+                runningTasks++;
+            }
+            task();
+            task=nullptr;
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                runningTasks--;
+            }
+            idle.notify_all();
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<unsigned int> nextQueue{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    size_t queuedTasks=0;   //Guarded by sleepMutex, as are the three below
+    size_t runningTasks=0;
+    bool paused=false;
+    bool stopping=false;
+};
+
+//Thread-safe list that workers append finished results to and the UI thread drains once per frame
+template<class T> class ResultQueue {
+public:
+    void Push(const T &item) {
+        std::lock_guard<std::mutex> lock(m);
+        items.push_back(item);
+    }
+    //Moves everything queued so far onto the end of out
+    void TakeAll(std::vector<T> &out) {
+        std::lock_guard<std::mutex> lock(m);
+        out.insert(out.end(),items.begin(),items.end());
+        items.clear();
+    }
+    void Clear() {
+        std::lock_guard<std::mutex> lock(m);
+        items.clear();
+    }
+private:
+    std::mutex m;
+    std::vector<T> items;
+};
+
+#endif // MSETTHREADPOOL_HPP
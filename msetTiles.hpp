@@ -0,0 +1,70 @@
+//Square tiles of the image, the unit of work the scheduler hands out (see msetScheduler.hpp).  Points stay in row-major order in the PointStore, so a tile
+//is tileSize row segments of tileSize points each.  Tiles are numbered row-major from the top left.  A batch of whole tiles covers a compact patch of the
+//image rather than a long span of rows, so its points cost much the same, and the tiles nearest the part of the image being looked at can go first.
+#ifndef MSETTILES_HPP
+#define MSETTILES_HPP
+
+#include <vector>
+#include <algorithm>
+#include "msetCore.hpp"
+
+//A tile finished by the scheduler, with the number of its points that were computed: all of them, unless only part of the tile was queued
+struct TileResult {
+    int tile;
+    unsigned int points;
+};
+
+struct TileGrid {
+    int res=1024;      //Image width and height in points.  Must be a multiple of tileSize.
+    int tileSize=32;
+
+    int TilesPerRow() const { return res/tileSize; }
+    int Count() const { return TilesPerRow()*TilesPerRow(); }
+    int_vector2 Origin(int tile) const { return {(tile%TilesPerRow())*tileSize,(tile/TilesPerRow())*tileSize}; }
+    //Row r (0 to tileSize-1) of a tile
+    IndexRange Row(int tile, int r) const {
+        int_vector2 o=Origin(tile);
+        size_t start=(size_t)res*(o.y+r)+o.x;
+        return {start,start+tileSize};
+    }
+
+    //Every tile with points in ranges, with how many, ordered by the distance of the tile's center from focus, nearest first.  ranges must be sorted and
+    //not overlap, as ShiftPoints and ZoomPoints return them.
+    std::vector<TileResult> TilesFor(const std::vector<IndexRange> &ranges, int_vector2 focus) const {
+        std::vector<unsigned int> points(Count(),0);
+        for (const IndexRange &range:ranges) {
+            size_t i=range.start;
+            while (i<range.end) {
+                int x=(int)(i%res), y=(int)(i/res);
+                int xEnd=std::min(res,x+(int)std::min(range.end-i,(size_t)(res-x)));
+                while (x<xEnd) {
+                    int tileEnd=std::min(xEnd,(x/tileSize+1)*tileSize);
+                    points[(y/tileSize)*TilesPerRow()+x/tileSize]+=tileEnd-x;
+                    i+=tileEnd-x;
+                    x=tileEnd;
+                }
+            }
+        }
+        std::vector<TileResult> tiles;
+        for (int t=0;t<Count();t++) if (points[t]>0) tiles.push_back({t,points[t]});
+        auto distance=[&](const TileResult &tile) {
+            int_vector2 o=Origin(tile.tile);
+            long long dx=2LL*(o.x-focus.x)+tileSize, dy=2LL*(o.y-focus.y)+tileSize;  //Twice the offset of the tile's center
+            return dx*dx+dy*dy;
+        };
+        std::stable_sort(tiles.begin(),tiles.end(),[&](const TileResult &a, const TileResult &b) { return distance(a)<distance(b); });
+        return tiles;
+    }
+};
+
+//Calls f with each part of row that lies in ranges, which must be sorted and not overlap
+template<class F>
+inline void ForEachRangeIn(const std::vector<IndexRange> &ranges, IndexRange row, F &&f) {
+    auto r=std::upper_bound(ranges.begin(),ranges.end(),row.start,[](size_t i, const IndexRange &range) { return i<range.end; });
+    for (;(r!=ranges.end()) && (r->start<row.end);++r) {
+        IndexRange part={std::max(r->start,row.start),std::min(r->end,row.end)};
+        if (part.Size()>0) f(part);
+    }
+}
+
+#endif // MSETTILES_HPP
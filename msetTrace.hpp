@@ -0,0 +1,165 @@
+//Hot-path tracing.  Build with -DMSET_TRACE=1 to record every batch (start, end, thread, type, pixels and iterations) and the phases of the explorer's
+//main loop, and to show iterations per second per type in the sidebar.  Without it every macro below expands to nothing and TraceBatch is a plain call,
+//so the kernels and the main loop compile exactly as if this file did not exist.
+//
+//Each thread writes its events to its own ring buffer, which no other thread writes to, so recording takes no lock: the event is stored and the buffer's
+//count is then published with a release store.  TraceDump() copies every buffer while the workers carry on and writes the most recent events of each
+//thread as a Chrome trace-event JSON file, which chrome://tracing or https://ui.perfetto.dev can open.
+#ifndef MSETTRACE_HPP
+#define MSETTRACE_HPP
+
+#ifndef MSET_TRACE
+#define MSET_TRACE 0
+#endif
+
+#include "msetCore.hpp"
+
+#if MSET_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct TraceEvent {
+    const char *name;  //Must be a string literal: only the pointer is kept
+    int64_t startNs, endNs;
+    int type;          //Float type 1-3 for batches, 0 for main loop phases
+    uint32_t pixels;
+    uint64_t iterations;
+};
+
+//Events kept per thread.  Older events are overwritten.
+const size_t traceRingSize=1<<16;
+
+struct TraceRing {
+    std::string threadName;
+    int threadId;
+    std::unique_ptr<TraceEvent[]> events{new TraceEvent[traceRingSize]};
+    std::atomic<uint64_t> written{0};  //Events ever written.  Slot written%traceRingSize is the next one.
+
+    void Record(const TraceEvent &e) {
+        uint64_t n=written.load(std::memory_order_relaxed);
+        events[n%traceRingSize]=e;
+        written.store(n+1,std::memory_order_release);
+    }
+};
+
+struct TraceRegistry {
+    std::mutex m;  //Only taken when a thread records its first event, and by TraceDump
+    std::vector<std::unique_ptr<TraceRing>> rings;
+    std::chrono::steady_clock::time_point epoch=std::chrono::steady_clock::now();
+    std::atomic<unsigned long long> iterations[4]={};  //Per type, for the sidebar's iterations per second
+};
+
+inline TraceRegistry& Tracer() {
+    static TraceRegistry registry;
+    return registry;
+}
+
+inline int64_t TraceNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-Tracer().epoch).count();
+}
+
+//The calling thread's ring, registered on first use
+inline TraceRing& ThreadTraceRing(const char *name=nullptr) {
+    thread_local TraceRing *ring=nullptr;
+    if (!ring) {
+        TraceRegistry &tracer=Tracer();
+        std::lock_guard<std::mutex> lock(tracer.m);
+        tracer.rings.emplace_back(new TraceRing);
+        ring=tracer.rings.back().get();
+        ring->threadId=(int)tracer.rings.size();
+        ring->threadName=name?name:"worker "+std::to_string(ring->threadId);
+    }
+    return *ring;
+}
+
+//Records the span from construction to End() (or destruction) on the calling thread
+class TraceSpan {
+public:
+    explicit TraceSpan(const char *name, int type=0) : name(name), type(type), start(TraceNow()) {}
+    ~TraceSpan() { End(); }
+    void End(uint32_t pixels=0, uint64_t iterations=0) {
+        if (ended) return;
+        ended=true;
+        ThreadTraceRing().Record({name,start,TraceNow(),type,pixels,iterations});
+    }
+private:
+    const char *name;
+    int type;
+    int64_t start;
+    bool ended=false;
+};
+
+//Runs calc(), a kernel over range of points, and records it as a batch of the given type with the iterations it did (see IterationCounter)
+template<class StoreType, class Calc>
+inline IndexRange TraceBatch(int type, StoreType &points, IndexRange range, Calc &&calc) {
+    TraceSpan span("batch",type);
+    IterationCounter counter(points,range);
+    IndexRange done=calc();
+    unsigned long long iterations=counter.Done(points,done);
+    span.End((uint32_t)done.Size(),iterations);
+    Tracer().iterations[type&3]+=iterations;
+    return done;
+}
+
+inline unsigned long long TraceIterations(int type) {
+    return Tracer().iterations[type&3].load(std::memory_order_relaxed);
+}
+
+//Writes the events still in every thread's ring.  Safe while the workers are running.
+inline bool TraceDump(const std::string &fileName) {
+    TraceRegistry &tracer=Tracer();
+    std::ofstream out(fileName);
+    out<<"{\"traceEvents\":[\n";
+    bool first=true;
+    std::lock_guard<std::mutex> lock(tracer.m);
+    for (const auto &ring:tracer.rings) {
+        out<<(first?"":",\n")<<"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"<<ring->threadId<<",\"args\":{\"name\":\""<<ring->threadName<<"\"}}";
+        first=false;
+        uint64_t end=ring->written.load(std::memory_order_acquire);
+        uint64_t begin=(end>traceRingSize)?end-traceRingSize:0;
+        std::vector<TraceEvent> events;
+        for (uint64_t n=begin;n<end;n++) events.push_back(ring->events[n%traceRingSize]);
+        //Slots the owner may have overwritten while we copied are dropped
+        uint64_t endAfter=ring->written.load(std::memory_order_acquire);
+        uint64_t firstIntact=(endAfter+1>traceRingSize)?endAfter+1-traceRingSize:0;
+        for (uint64_t n=std::max(begin,firstIntact);n<end;n++) {
+            const TraceEvent &e=events[n-begin];
+            out<<",\n{\"name\":\""<<e.name<<"\",\"cat\":\""<<(e.type?"type "+std::to_string(e.type):std::string("main loop"))<<"\",\"ph\":\"X\",\"pid\":1,\"tid\":"<<ring->threadId
+               <<",\"ts\":"<<e.startNs/1000.0<<",\"dur\":"<<(e.endNs-e.startNs)/1000.0;
+            if (e.type) out<<",\"args\":{\"type\":"<<e.type<<",\"pixels\":"<<e.pixels<<",\"iterations\":"<<e.iterations<<"}";
+            out<<"}";
+        }
+    }
+    out<<"\n]}\n";
+    return out.good();
+}
+
+#define MSET_TRACE_CONCAT2(a,b) a##b
+#define MSET_TRACE_CONCAT(a,b) MSET_TRACE_CONCAT2(a,b)
+#define MSET_TRACE_SCOPE(name) TraceSpan MSET_TRACE_CONCAT(traceSpan,__LINE__)(name)
+#define MSET_TRACE_BEGIN(span,...) TraceSpan span(__VA_ARGS__)
+#define MSET_TRACE_END(span) span.End()
+#define MSET_TRACE_END_BATCH(span,type,pixels,count) do { span.End((uint32_t)(pixels),(count)); Tracer().iterations[(type)&3]+=(count); } while (0)
+#define MSET_TRACE_THREAD_NAME(name) ThreadTraceRing(name)
+
+#else
+
+template<class StoreType, class Calc>
+inline IndexRange TraceBatch(int, StoreType&, IndexRange, Calc &&calc) { return calc(); }
+
+#define MSET_TRACE_SCOPE(name)
+#define MSET_TRACE_BEGIN(span,...)
+#define MSET_TRACE_END(span)
+#define MSET_TRACE_END_BATCH(span,type,pixels,count)
+#define MSET_TRACE_THREAD_NAME(name)
+
+#endif // MSET_TRACE
+
+#endif // MSETTRACE_HPP
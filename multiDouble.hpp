@@ -0,0 +1,364 @@
+//Double-double (~106 bits) and quad-double (~212 bits) floating point types built from hardware doubles, after the QD library by Hida, Li and Bailey.
+//A value is the unevaluated sum of 2 or 4 non-overlapping doubles, and arithmetic is done with error-free transformations (two_sum, two_prod),
+//so these run far faster than cpp_bin_float_quad and cpp_bin_float_oct for a little less precision.  Their rounding differs from those types too,
+//which makes them worth comparing in their own right.
+//
+//They provide everything the rest of the program asks of a float type (arithmetic and comparisons, conversions to and from the built-in types,
+//stream input and output, ldexp and std::numeric_limits), so either can be used in the typedefs for first_float, second_float or third_float.
+//double_double operations are branch-free straight-line double arithmetic, so loops over them can be vectorized like plain double code.
+#ifndef MULTIDOUBLE_HPP
+#define MULTIDOUBLE_HPP
+
+#include <cmath>
+#include <limits>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "boost/multiprecision/cpp_bin_float.hpp"
+
+namespace multiDouble {
+
+//Wide enough to hold any double_double or quad_double whose parts are not spread over a vast exponent range.  Only used for decimal input and output.
+typedef boost::multiprecision::number<boost::multiprecision::backends::cpp_bin_float<320, boost::multiprecision::backends::digit_base_2, void, std::int32_t, -262142, 262143>,
+                                      boost::multiprecision::et_off> wide_float;
+
+//s+err == a+b exactly
+inline double two_sum(double a, double b, double &err) {
+    double s=a+b;
+    double bb=s-a;
+    err=(a-(s-bb))+(b-bb);
+    return s;
+}
+
+//As two_sum, but requires |a|>=|b|
+inline double quick_two_sum(double a, double b, double &err) {
+    double s=a+b;
+    err=b-(s-a);
+    return s;
+}
+
+//p+err == a*b exactly.  Uses a hardware FMA when the compiler targets one; otherwise Dekker's splitting.
+//(Compilers only contract a*b+c into an FMA when the target has one, which is exactly when the first branch is taken, so the split below is never disturbed.)
+inline double two_prod(double a, double b, double &err) {
+    double p=a*b;
+#if defined(FP_FAST_FMA) || defined(__FP_FAST_FMA)
+    err=std::fma(a,b,-p);
+#else
+    const double splitter=134217729.0;  //2^27+1
+    double t=splitter*a;
+    double a_hi=t-(t-a);
+    double a_lo=a-a_hi;
+    t=splitter*b;
+    double b_hi=t-(t-b);
+    double b_lo=b-b_hi;
+    err=((a_hi*b_hi-p)+a_hi*b_lo+a_lo*b_hi)+a_lo*b_lo;
+#endif
+    return p;
+}
+
+//(a,b,c) <- three-way error-free sum, largest part in a
+inline void three_sum(double &a, double &b, double &c) {
+    double t1, t2, t3;
+    t1=two_sum(a,b,t2);
+    a=two_sum(c,t1,t3);
+    b=two_sum(t2,t3,c);
+}
+
+//As three_sum but only two outputs are kept
+inline void three_sum2(double &a, double &b, double c) {
+    double t1, t2, t3;
+    t1=two_sum(a,b,t2);
+    a=two_sum(c,t1,t3);
+    b=t2+t3;
+}
+
+//Renormalizes five overlapping parts into four non-overlapping ones
+inline void renorm(double &c0, double &c1, double &c2, double &c3, double c4) {
+    if (std::isinf(c0)) return;
+    double s0, s1, s2=0.0, s3=0.0;
+    s0=quick_two_sum(c3,c4,c4);
+    s0=quick_two_sum(c2,s0,c3);
+    s0=quick_two_sum(c1,s0,c2);
+    c0=quick_two_sum(c0,s0,c1);
+    s0=c0;
+    s1=c1;
+    if (s1!=0.0) {
+        s1=quick_two_sum(s1,c2,s2);
+        if (s2!=0.0) {
+            s2=quick_two_sum(s2,c3,s3);
+            if (s3!=0.0) s3+=c4;
+            else s2=quick_two_sum(s2,c4,s3);
+        }
+        else {
+            s1=quick_two_sum(s1,c3,s2);
+            if (s2!=0.0) s2=quick_two_sum(s2,c4,s3);
+            else s1=quick_two_sum(s1,c4,s2);
+        }
+    }
+    else {
+        s0=quick_two_sum(s0,c2,s1);
+        if (s1!=0.0) {
+            s1=quick_two_sum(s1,c3,s2);
+            if (s2!=0.0) s2=quick_two_sum(s2,c4,s3);
+            else s1=quick_two_sum(s1,c4,s2);
+        }
+        else {
+            s0=quick_two_sum(s0,c3,s1);
+            if (s1!=0.0) s1=quick_two_sum(s1,c4,s2);
+            else s0=quick_two_sum(s0,c4,s1);
+        }
+    }
+    c0=s0; c1=s1; c2=s2; c3=s3;
+}
+
+} // namespace multiDouble
+
+class double_double {
+public:
+    double hi;
+    double lo;
+
+    double_double() : hi(0.0), lo(0.0) {}
+    double_double(double h) : hi(h), lo(0.0) {}
+    double_double(int i) : hi((double)i), lo(0.0) {}
+    double_double(unsigned int i) : hi((double)i), lo(0.0) {}
+    double_double(long long i) { hi=multiDouble::two_sum((double)(i>>32)*4294967296.0,(double)(i&0xFFFFFFFFLL),lo); }  //64-bit integers may not fit in one double, but each 32-bit half does
+    double_double(unsigned long long i) { hi=multiDouble::two_sum((double)(i>>32)*4294967296.0,(double)(i&0xFFFFFFFFULL),lo); }
+    double_double(long i) : double_double((long long)i) {}
+    double_double(unsigned long i) : double_double((unsigned long long)i) {}
+    double_double(double h, double l) { hi=multiDouble::quick_two_sum(h,l,lo); }
+
+    explicit operator double() const { return hi+lo; }
+    explicit operator int() const { return (int)to_wide(); }  //Truncates toward zero like a built-in cast, without the rounding of hi+lo getting in the way
+    explicit operator long long() const { return (long long)to_wide(); }
+
+    double_double operator-() const { return double_double(-hi,-lo); }
+
+    friend double_double operator+(const double_double &a, const double_double &b) {
+        double s1, s2, t1, t2;
+        s1=multiDouble::two_sum(a.hi,b.hi,s2);
+        t1=multiDouble::two_sum(a.lo,b.lo,t2);
+        s2+=t1;
+        s1=multiDouble::quick_two_sum(s1,s2,s2);
+        s2+=t2;
+        double_double r;
+        r.hi=multiDouble::quick_two_sum(s1,s2,r.lo);
+        return r;
+    }
+    friend double_double operator-(const double_double &a, const double_double &b) { return a+(-b); }
+    friend double_double operator*(const double_double &a, const double_double &b) {
+        double p, e;
+        p=multiDouble::two_prod(a.hi,b.hi,e);
+        e+=(a.hi*b.lo+a.lo*b.hi);
+        double_double r;
+        r.hi=multiDouble::quick_two_sum(p,e,r.lo);
+        return r;
+    }
+    friend double_double operator/(const double_double &a, const double_double &b) {
+        double q1=a.hi/b.hi;
+        double_double r=a-q1*b;
+        double q2=r.hi/b.hi;
+        r=r-q2*b;
+        double q3=r.hi/b.hi;
+        double_double q(q1,q2);
+        return q+double_double(q3);
+    }
+    double_double& operator+=(const double_double &b) { *this=*this+b; return *this; }
+    double_double& operator-=(const double_double &b) { *this=*this-b; return *this; }
+    double_double& operator*=(const double_double &b) { *this=*this*b; return *this; }
+    double_double& operator/=(const double_double &b) { *this=*this/b; return *this; }
+
+    friend bool operator<(const double_double &a, const double_double &b) { return (a.hi<b.hi) || ((a.hi==b.hi)&&(a.lo<b.lo)); }
+    friend bool operator>(const double_double &a, const double_double &b) { return b<a; }
+    friend bool operator<=(const double_double &a, const double_double &b) { return !(b<a); }
+    friend bool operator>=(const double_double &a, const double_double &b) { return !(a<b); }
+    friend bool operator==(const double_double &a, const double_double &b) { return (a.hi==b.hi)&&(a.lo==b.lo); }
+    friend bool operator!=(const double_double &a, const double_double &b) { return !(a==b); }
+
+    //Exact scaling by a power of two
+    friend double_double ldexp(const double_double &a, int e) { return double_double(std::ldexp(a.hi,e),std::ldexp(a.lo,e)); }
+    friend double_double abs(const double_double &a) { return (a.hi<0.0)?-a:a; }
+
+    multiDouble::wide_float to_wide() const { return multiDouble::wide_float(hi)+multiDouble::wide_float(lo); }
+    static double_double from_wide(multiDouble::wide_float w) {
+        double_double r;
+        r.hi=(double)w;
+        w-=r.hi;
+        r.lo=(double)w;
+        return r;
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, const double_double &a) { return os<<a.to_wide(); }
+    friend std::istream& operator>>(std::istream &is, double_double &a) {
+        multiDouble::wide_float w;
+        if (is>>w) a=from_wide(w);
+        return is;
+    }
+};
+
+class quad_double {
+public:
+    double x[4];
+
+    quad_double() { x[0]=x[1]=x[2]=x[3]=0.0; }
+    quad_double(double d) { x[0]=d; x[1]=x[2]=x[3]=0.0; }
+    quad_double(int i) : quad_double((double)i) {}
+    quad_double(unsigned int i) : quad_double((double)i) {}
+    quad_double(long long i) { double_double d(i); x[0]=d.hi; x[1]=d.lo; x[2]=x[3]=0.0; }
+    quad_double(unsigned long long i) { double_double d(i); x[0]=d.hi; x[1]=d.lo; x[2]=x[3]=0.0; }
+    quad_double(long i) : quad_double((long long)i) {}
+    quad_double(unsigned long i) : quad_double((unsigned long long)i) {}
+    quad_double(const double_double &d) { x[0]=d.hi; x[1]=d.lo; x[2]=x[3]=0.0; }
+    quad_double(double c0, double c1, double c2, double c3) {
+        x[0]=c0; x[1]=c1; x[2]=c2; x[3]=c3;
+        multiDouble::renorm(x[0],x[1],x[2],x[3],0.0);
+    }
+
+    explicit operator double() const { return x[0]+(x[1]+(x[2]+x[3])); }
+    explicit operator int() const { return (int)to_wide(); }
+    explicit operator long long() const { return (long long)to_wide(); }
+
+    quad_double operator-() const {
+        quad_double r;
+        for (int i=0;i<4;i++) r.x[i]=-x[i];
+        return r;
+    }
+
+    friend quad_double operator+(const quad_double &a, const quad_double &b) {
+        double s0, s1, s2, s3, t0, t1, t2, t3;
+        s0=multiDouble::two_sum(a.x[0],b.x[0],t0);
+        s1=multiDouble::two_sum(a.x[1],b.x[1],t1);
+        s2=multiDouble::two_sum(a.x[2],b.x[2],t2);
+        s3=multiDouble::two_sum(a.x[3],b.x[3],t3);
+        s1=multiDouble::two_sum(s1,t0,t0);
+        multiDouble::three_sum(s2,t0,t1);
+        multiDouble::three_sum2(s3,t0,t2);
+        t0=t0+t1+t3;
+        multiDouble::renorm(s0,s1,s2,s3,t0);
+        quad_double r;
+        r.x[0]=s0; r.x[1]=s1; r.x[2]=s2; r.x[3]=s3;
+        return r;
+    }
+    friend quad_double operator-(const quad_double &a, const quad_double &b) { return a+(-b); }
+    friend quad_double operator*(const quad_double &a, const quad_double &b) {
+        double p0, p1, p2, p3, p4, p5;
+        double q0, q1, q2, q3, q4, q5;
+        double t0, t1;
+        double s0, s1, s2;
+        p0=multiDouble::two_prod(a.x[0],b.x[0],q0);
+        p1=multiDouble::two_prod(a.x[0],b.x[1],q1);
+        p2=multiDouble::two_prod(a.x[1],b.x[0],q2);
+        p3=multiDouble::two_prod(a.x[0],b.x[2],q3);
+        p4=multiDouble::two_prod(a.x[1],b.x[1],q4);
+        p5=multiDouble::two_prod(a.x[2],b.x[0],q5);
+        multiDouble::three_sum(p1,p2,q0);          //O(eps) terms
+        multiDouble::three_sum(p2,q1,q2);          //O(eps^2) terms: six-three sum of p2, q1, q2, p3, p4, p5
+        multiDouble::three_sum(p3,p4,p5);
+        s0=multiDouble::two_sum(p2,p3,t0);
+        s1=multiDouble::two_sum(q1,p4,t1);
+        s2=q2+p5;
+        s1=multiDouble::two_sum(s1,t0,t0);
+        s2+=(t0+t1);
+        s1+=a.x[0]*b.x[3]+a.x[1]*b.x[2]+a.x[2]*b.x[1]+a.x[3]*b.x[0]+q0+q3+q4+q5;  //O(eps^3) terms
+        multiDouble::renorm(p0,p1,s0,s1,s2);
+        quad_double r;
+        r.x[0]=p0; r.x[1]=p1; r.x[2]=s0; r.x[3]=s1;
+        return r;
+    }
+    friend quad_double operator/(const quad_double &a, const quad_double &b) {
+        double q0, q1, q2, q3;
+        q0=a.x[0]/b.x[0];
+        quad_double r=a-b*quad_double(q0);
+        q1=r.x[0]/b.x[0];
+        r=r-b*quad_double(q1);
+        q2=r.x[0]/b.x[0];
+        r=r-b*quad_double(q2);
+        q3=r.x[0]/b.x[0];
+        return quad_double(q0,q1,q2,q3);
+    }
+    quad_double& operator+=(const quad_double &b) { *this=*this+b; return *this; }
+    quad_double& operator-=(const quad_double &b) { *this=*this-b; return *this; }
+    quad_double& operator*=(const quad_double &b) { *this=*this*b; return *this; }
+    quad_double& operator/=(const quad_double &b) { *this=*this/b; return *this; }
+
+    friend bool operator<(const quad_double &a, const quad_double &b) {
+        for (int i=0;i<4;i++) {
+            if (a.x[i]<b.x[i]) return true;
+            if (a.x[i]>b.x[i]) return false;
+        }
+        return false;
+    }
+    friend bool operator>(const quad_double &a, const quad_double &b) { return b<a; }
+    friend bool operator<=(const quad_double &a, const quad_double &b) { return !(b<a); }
+    friend bool operator>=(const quad_double &a, const quad_double &b) { return !(a<b); }
+    friend bool operator==(const quad_double &a, const quad_double &b) { return (a.x[0]==b.x[0])&&(a.x[1]==b.x[1])&&(a.x[2]==b.x[2])&&(a.x[3]==b.x[3]); }
+    friend bool operator!=(const quad_double &a, const quad_double &b) { return !(a==b); }
+
+    friend quad_double ldexp(const quad_double &a, int e) {
+        quad_double r;
+        for (int i=0;i<4;i++) r.x[i]=std::ldexp(a.x[i],e);
+        return r;
+    }
+    friend quad_double abs(const quad_double &a) { return (a.x[0]<0.0)?-a:a; }
+
+    multiDouble::wide_float to_wide() const {
+        multiDouble::wide_float w(x[3]);
+        w+=x[2]; w+=x[1]; w+=x[0];
+        return w;
+    }
+    static quad_double from_wide(multiDouble::wide_float w) {
+        quad_double r;
+        for (int i=0;i<4;i++) {
+            r.x[i]=(double)w;
+            w-=r.x[i];
+        }
+        return r;
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, const quad_double &a) { return os<<a.to_wide(); }
+    friend std::istream& operator>>(std::istream &is, quad_double &a) {
+        multiDouble::wide_float w;
+        if (is>>w) a=from_wide(w);
+        return is;
+    }
+};
+
+namespace std {
+
+template<> class numeric_limits<double_double> : public numeric_limits<double> {
+public:
+    static constexpr int digits=106;
+    static constexpr int digits10=31;
+    static constexpr int max_digits10=33;
+    static constexpr int min_exponent=-968;      //Below 2^-969 the low part underflows and precision drops
+    static constexpr int min_exponent10=-291;
+    static double_double epsilon() { return double_double(std::ldexp(1.0,1-digits)); }
+    static double_double min() { return double_double(std::ldexp(1.0,min_exponent-1)); }
+    static double_double max() { return double_double(numeric_limits<double>::max(),std::ldexp(numeric_limits<double>::max(),-54)); }
+    static double_double lowest() { return -max(); }
+    static double_double round_error() { return double_double(0.5); }
+    static double_double infinity() { return double_double(numeric_limits<double>::infinity()); }
+    static double_double quiet_NaN() { return double_double(numeric_limits<double>::quiet_NaN()); }
+    static double_double denorm_min() { return double_double(numeric_limits<double>::denorm_min()); }
+};
+
+template<> class numeric_limits<quad_double> : public numeric_limits<double> {
+public:
+    static constexpr int digits=212;
+    static constexpr int digits10=62;
+    static constexpr int max_digits10=65;
+    static constexpr int min_exponent=-862;      //Below 2^-863 the lowest part underflows
+    static constexpr int min_exponent10=-259;
+    static quad_double epsilon() { return quad_double(std::ldexp(1.0,1-digits)); }
+    static quad_double min() { return quad_double(std::ldexp(1.0,min_exponent-1)); }
+    static quad_double max() { return quad_double(numeric_limits<double>::max()); }
+    static quad_double lowest() { return -max(); }
+    static quad_double round_error() { return quad_double(0.5); }
+    static quad_double infinity() { return quad_double(numeric_limits<double>::infinity()); }
+    static quad_double quiet_NaN() { return quad_double(numeric_limits<double>::quiet_NaN()); }
+    static quad_double denorm_min() { return quad_double(numeric_limits<double>::denorm_min()); }
+};
+
+} // namespace std
+
+#endif // MULTIDOUBLE_HPP